@@ -0,0 +1,155 @@
+#include "SnowUI/Core/Window.h"
+#include "SnowUI/Widgets/DataGrid.h"
+#include "SnowUI/Render/OpenGLBackend.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+
+using namespace SnowUI;
+
+// Synthetic soil-sample table: cells are computed from the row index, so
+// ten million rows cost no memory
+class SoilSampleSource : public IDataSource
+{
+  public:
+	explicit SoilSampleSource(size_t rowCount) : rowCount_(rowCount)
+	{
+	}
+
+	size_t GetRowCount() const override
+	{
+		return rowCount_;
+	}
+
+	size_t GetColumnCount() const override
+	{
+		return 6;
+	}
+
+	std::string GetColumnName(size_t column) const override
+	{
+		static const char* names[] = {"Sample", "Depth (m)", "Density (kg/m3)", "Moisture (%)", "Cohesion (kPa)",
+		                              "Friction (deg)"};
+		return names[column];
+	}
+
+	void FormatCell(size_t row, size_t column, std::string& out) const override
+	{
+		const double noise = static_cast<double>(Hash(row * 8 + column) % 10000) / 10000.0;
+		char buffer[32];
+		switch (column)
+		{
+		case 0:
+			std::snprintf(buffer, sizeof(buffer), "S-%08zu", row);
+			break;
+		case 1:
+			std::snprintf(buffer, sizeof(buffer), "%.2f", 0.25 * static_cast<double>(row % 400) + noise);
+			break;
+		case 2:
+			std::snprintf(buffer, sizeof(buffer), "%.0f", 1400.0 + 700.0 * noise);
+			break;
+		case 3:
+			std::snprintf(buffer, sizeof(buffer), "%.1f", 5.0 + 40.0 * noise);
+			break;
+		case 4:
+			std::snprintf(buffer, sizeof(buffer), "%.1f", 80.0 * noise);
+			break;
+		default:
+			std::snprintf(buffer, sizeof(buffer), "%.1f", 20.0 + 25.0 * noise);
+			break;
+		}
+		out = buffer;
+	}
+
+  private:
+	static uint64_t Hash(uint64_t x)
+	{
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		return x;
+	}
+
+	size_t rowCount_;
+};
+
+template <typename F> static double MeasureMicroseconds(F&& f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Times the grid's own work (setup, recording frames) before showing it
+static void RunBenchmark(DataGrid& grid, SoilSampleSource& source)
+{
+	const int frames = 1000;
+	DrawList drawList;
+
+	const double setup = MeasureMicroseconds([&] { grid.SetDataSource(&source); });
+	const double firstFrame = MeasureMicroseconds([&] { grid.Paint(drawList); });
+
+	// Jumps anywhere in the table: every frame formats a screen of new rows
+	uint64_t seed = 12345;
+	const double jumps = MeasureMicroseconds([&] {
+		for (int i = 0; i < frames; ++i)
+		{
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			grid.SetScrollOffset(static_cast<double>(seed >> 11) / static_cast<double>(1ULL << 53) *
+			                     grid.GetMaxScrollOffset());
+			drawList.Clear();
+			grid.Paint(drawList);
+		}
+	});
+
+	// Smooth scrolling: most rows come from the cell cache
+	const double smooth = MeasureMicroseconds([&] {
+		for (int i = 0; i < frames; ++i)
+		{
+			grid.SetScrollOffset(grid.GetScrollOffset() + DataGrid::kRowHeight);
+			drawList.Clear();
+			grid.Paint(drawList);
+		}
+	});
+
+	const DataGridCacheStats& stats = grid.GetCacheStats();
+	std::printf("DataGrid benchmark, %zu rows x %zu columns\n", source.GetRowCount(), source.GetColumnCount());
+	std::printf("  SetDataSource (incl. column sizing): %.0f us\n", setup);
+	std::printf("  first frame:                         %.0f us, %zu commands\n", firstFrame,
+	            drawList.GetCommands().size());
+	std::printf("  random jump frame:                   %.1f us\n", jumps / frames);
+	std::printf("  one-row scroll frame:                %.1f us\n", smooth / frames);
+	std::printf("  cell cache: %llu hits, %llu misses\n", static_cast<unsigned long long>(stats.hits),
+	            static_cast<unsigned long long>(stats.misses));
+	grid.SetScrollOffset(0.0);
+}
+
+int main()
+{
+	std::cout << "SnowUI Data Grid Demo" << std::endl;
+
+	OpenGLBackend backend;
+
+	auto window = std::make_shared<Window>();
+	if (!window->Create("Data Grid Demo", 800, 600, &backend))
+	{
+		std::cerr << "Failed to create window" << std::endl;
+		return 1;
+	}
+
+	SoilSampleSource source(10000000);
+	auto dataGrid = std::make_shared<DataGrid>();
+	dataGrid->SetBounds(Rect(10, 10, 780, 580));
+	RunBenchmark(*dataGrid, source);
+
+	window->AddChild(dataGrid);
+
+	std::cout << "Running data grid window (close window to exit)..." << std::endl;
+	window->Run();
+
+	std::cout << "Demo completed successfully!" << std::endl;
+
+	return 0;
+}
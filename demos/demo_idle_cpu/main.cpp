@@ -0,0 +1,252 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#undef CreateWindow
+#else
+#include <sys/resource.h>
+#endif
+
+#include "SnowUI/Core/Window.h"
+#include "SnowUI/Widgets/Label.h"
+#include "SnowUI/Render/OpenGLBackend.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace SnowUI;
+
+static constexpr auto kInterval = std::chrono::seconds(2);
+
+static int g_failures = 0;
+
+static void Check(bool condition, const char* what)
+{
+	if (!condition)
+	{
+		std::printf("  FAILED: %s\n", what);
+		g_failures++;
+	}
+}
+
+// User plus system CPU time of the whole process
+static double GetProcessCpuMilliseconds()
+{
+#ifdef _WIN32
+	FILETIME creation, exit, kernel, user;
+	GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+	const auto toMilliseconds = [](const FILETIME& time) {
+		return static_cast<double>((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 1e4;
+	};
+	return toMilliseconds(kernel) + toMilliseconds(user);
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 +
+	       static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e3;
+#endif
+}
+
+// Headless stand-in for a windowed backend: WaitEvents() sleeps until
+// PostEmptyEvent() or the timeout like the platform's event wait, and
+// counts how often the loop woke up and drew
+class EventWaitBackend : public IRenderBackend
+{
+  public:
+	bool Initialize(int width, int height) override
+	{
+		(void)width;
+		(void)height;
+		return true;
+	}
+	void Shutdown() override
+	{
+	}
+	void BeginFrame() override
+	{
+	}
+	void EndFrame() override
+	{
+		frames_++;
+	}
+	void ExecuteDrawList(const DrawList& drawList) override
+	{
+		(void)drawList;
+	}
+	void Resize(int width, int height) override
+	{
+		(void)width;
+		(void)height;
+	}
+
+	bool CreateWindow(const std::string& title, int width, int height) override
+	{
+		(void)title;
+		(void)width;
+		(void)height;
+		return true;
+	}
+	bool ShouldClose() override
+	{
+		return false;
+	}
+	bool WaitEvents(double timeoutSeconds) override
+	{
+		wakeups_++;
+		std::unique_lock<std::mutex> lock(mutex_);
+		const auto woken = [this] { return woken_; };
+		if (timeoutSeconds < 0.0)
+			wake_.wait(lock, woken);
+		else
+			wake_.wait_for(lock, std::chrono::duration<double>(timeoutSeconds), woken);
+		woken_ = false;
+		return false;
+	}
+	void PostEmptyEvent() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			woken_ = true;
+		}
+		wake_.notify_one();
+	}
+
+	uint64_t GetWakeups() const
+	{
+		return wakeups_;
+	}
+	uint64_t GetFrames() const
+	{
+		return frames_;
+	}
+
+  private:
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	bool woken_ = false;
+	uint64_t wakeups_ = 0;
+	uint64_t frames_ = 0;
+};
+
+struct IdleResult
+{
+	double cpuMilliseconds;
+	double wallMilliseconds;
+	uint64_t wakeups;
+	uint64_t frames;
+};
+
+// Runs a window of labels through Run() for kInterval, after setup() has
+// installed whatever timers the scenario needs, and closes it from another
+// thread as a platform close request would
+template <typename Setup> static IdleResult RunIdle(Setup&& setup)
+{
+	EventWaitBackend backend;
+	Window window;
+	window.Create("Idle", 800, 600, &backend);
+	for (int i = 0; i < 400; ++i)
+	{
+		Label* label = window.CreateWidget<Label>();
+		label->SetBounds(Rect(static_cast<float>(i % 8) * 100.0f, static_cast<float>(i / 8) * 12.0f, 96.0f, 12.0f));
+		label->SetText("Reading " + std::to_string(i));
+		window.AddChild(label);
+	}
+	setup(window);
+
+	std::thread closer([&window] {
+		std::this_thread::sleep_for(kInterval);
+		window.Post([&window] { window.Close(); });
+	});
+
+	const double cpuStart = GetProcessCpuMilliseconds();
+	const auto wallStart = std::chrono::steady_clock::now();
+	window.Run();
+	const auto wallEnd = std::chrono::steady_clock::now();
+	const double cpuEnd = GetProcessCpuMilliseconds();
+	closer.join();
+
+	IdleResult result;
+	result.cpuMilliseconds = cpuEnd - cpuStart;
+	result.wallMilliseconds = std::chrono::duration<double, std::milli>(wallEnd - wallStart).count();
+	result.wakeups = backend.GetWakeups();
+	result.frames = backend.GetFrames();
+	return result;
+}
+
+static void Report(const char* name, const IdleResult& result)
+{
+	std::printf("  %-26s: %5.0f ms wall, %7.2f ms CPU (%5.2f%%), %4llu wakeups, %3llu frames\n", name,
+	            result.wallMilliseconds, result.cpuMilliseconds, 100.0 * result.cpuMilliseconds / result.wallMilliseconds,
+	            static_cast<unsigned long long>(result.wakeups), static_cast<unsigned long long>(result.frames));
+}
+
+int main()
+{
+	std::cout << "SnowUI Idle CPU Demo" << std::endl;
+	const double seconds = std::chrono::duration<double>(kInterval).count();
+	std::printf("Process CPU time over %.0f s of Run() with 400 labels on screen:\n", seconds);
+
+	// Nothing to do: one frame, then the loop sleeps until the close request
+	const IdleResult idle = RunIdle([](Window&) {});
+	Report("idle", idle);
+	Check(idle.frames == 1, "an idle window draws only its first frame");
+	Check(idle.wakeups <= 2, "an idle window does not wake up");
+	Check(idle.cpuMilliseconds < 0.05 * idle.wallMilliseconds, "an idle window uses under 5% of a core");
+
+	// A 60 Hz timer whose callback changes nothing wakes the loop but never
+	// draws
+	uint64_t ticks = 0;
+	const IdleResult timer = RunIdle([&ticks](Window& window) {
+		window.SetTimer(std::chrono::milliseconds(16), [&ticks] { ticks++; });
+	});
+	Report("16 ms timer, no change", timer);
+	Check(timer.frames == 1, "timer wakeups without changes draw nothing");
+	Check(timer.wakeups <= ticks + 2, "one wakeup per timer tick");
+	Check(ticks >= static_cast<uint64_t>(seconds * 1000.0 / 16.0 * 0.5), "the timer keeps its rate");
+	if (timer.wakeups > 0)
+	{
+		std::printf("  %-26s: %7.2f us CPU per wakeup\n", "", 1000.0 * timer.cpuMilliseconds / timer.wakeups);
+	}
+
+	// A label updated twice a second redraws once per update
+	uint64_t shown = 0;
+	const IdleResult clock = RunIdle([&shown](Window& window) {
+		Label* clockLabel = window.CreateWidget<Label>();
+		clockLabel->SetBounds(Rect(700.0f, 580.0f, 96.0f, 16.0f));
+		window.AddChild(clockLabel);
+		window.SetTimer(std::chrono::milliseconds(500), [clockLabel, &shown] {
+			clockLabel->SetText(std::to_string(++shown));
+		});
+	});
+	Report("500 ms timer, one label", clock);
+	Check(clock.frames == 1 + shown, "one frame per label change");
+
+	// Shows the same labels in a real window, which should sit at 0% CPU
+	// until something happens
+	OpenGLBackend backend;
+	Window window;
+	if (!window.Create("Idle CPU Demo", 800, 600, &backend))
+	{
+		std::cerr << "Failed to create window" << std::endl;
+		return 1;
+	}
+	for (int i = 0; i < 400; ++i)
+	{
+		Label* label = window.CreateWidget<Label>();
+		label->SetBounds(Rect(static_cast<float>(i % 8) * 100.0f, static_cast<float>(i / 8) * 12.0f, 96.0f, 12.0f));
+		label->SetText("Reading " + std::to_string(i));
+		window.AddChild(label);
+	}
+
+	std::cout << "Running idle window (close window to exit)..." << std::endl;
+	window.Run();
+
+	std::cout << (g_failures == 0 ? "Demo completed successfully!" : "Demo completed with failures") << std::endl;
+
+	return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,419 @@
+#include "SnowUI/Core/Window.h"
+#include "SnowUI/Core/ThreadPool.h"
+#include "SnowUI/Widgets/Label.h"
+#include "SnowUI/Render/SoftwareBackend.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SnowUI;
+
+static constexpr int kPanels = 32;
+static constexpr int kChartsPerPanel = 40;
+static constexpr int kSamples = 96;
+
+template <typename F> static double MeasureMilliseconds(F&& f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Dashboard chart whose OnPaint() evaluates its series every time, the kind
+// of widget that makes recording the expensive part of a frame
+class Sparkline : public Widget
+{
+  public:
+	explicit Sparkline(float phase) : phase_(phase)
+	{
+	}
+
+	void OnPaint(DrawList& drawList) override
+	{
+		drawList.AddRect(bounds_, Color(0.12f, 0.14f, 0.16f, 1.0f));
+		float lastX = 0.0f, lastY = 0.0f;
+		for (int i = 0; i < kSamples; ++i)
+		{
+			const float t = static_cast<float>(i) / (kSamples - 1);
+			const float value = 0.5f + 0.3f * std::sin(phase_ + t * 9.0f) + 0.15f * std::sin(phase_ * 3.0f + t * 31.0f);
+			const float x = bounds_.x + t * bounds_.width;
+			const float y = bounds_.y + (1.0f - value) * bounds_.height;
+			if (i > 0)
+				drawList.AddLine(lastX, lastY, x, y, Color(0.3f, 0.8f, 0.5f, 1.0f));
+			lastX = x;
+			lastY = y;
+		}
+	}
+
+	// Reads only its own bounds and phase
+	bool IsPaintThreadSafe() const override
+	{
+		return true;
+	}
+
+	void SetPhase(float phase)
+	{
+		phase_ = phase;
+		Invalidate();
+	}
+
+  private:
+	float phase_;
+};
+
+// Backend that keeps what it was asked to draw, to compare the two modes
+class CaptureBackend : public IRenderBackend
+{
+  public:
+	bool Initialize(int width, int height) override
+	{
+		width_ = width;
+		height_ = height;
+		return true;
+	}
+	void Shutdown() override
+	{
+	}
+	void BeginFrame() override
+	{
+	}
+	void EndFrame() override
+	{
+	}
+	void ExecuteDrawList(const DrawList& drawList) override
+	{
+		if (capture_)
+		{
+			frame_.Clear();
+			frame_.Append(drawList);
+		}
+	}
+	void ExecuteDrawListPartial(const DrawList& drawList, DamageRegion& damage) override
+	{
+		ExecuteDrawList(drawList);
+		damage_ = damage.GetRects();
+	}
+	void ExecuteDrawChainPartial(const DrawChain& chain, DamageRegion& damage) override
+	{
+		if (capture_)
+			chain.Flatten(frame_);
+		damage_ = damage.GetRects();
+	}
+	void Resize(int width, int height) override
+	{
+		width_ = width;
+		height_ = height;
+	}
+
+	void SetCapture(bool capture)
+	{
+		capture_ = capture;
+	}
+	const DrawList& GetFrame() const
+	{
+		return frame_;
+	}
+	const std::vector<DamageRect>& GetDamage() const
+	{
+		return damage_;
+	}
+
+  private:
+	int width_ = 0;
+	int height_ = 0;
+	bool capture_ = false;
+	DrawList frame_;
+	std::vector<DamageRect> damage_;
+};
+
+struct Dashboard
+{
+	CaptureBackend backend;
+	Window window;
+	std::vector<Sparkline*> charts;
+};
+
+static void BuildDashboard(Dashboard& dashboard)
+{
+	dashboard.window.Create("Dashboard", 1920, 1080, &dashboard.backend);
+	dashboard.window.Show();
+
+	for (int panel = 0; panel < kPanels; ++panel)
+	{
+		const float panelX = static_cast<float>(panel % 8) * 240.0f;
+		const float panelY = static_cast<float>(panel / 8) * 270.0f;
+		auto container = std::make_shared<Widget>();
+		container->SetBounds(Rect(panelX, panelY, 236.0f, 266.0f));
+
+		auto title = std::make_shared<Label>();
+		title->SetBounds(Rect(panelX + 4.0f, panelY + 2.0f, 200.0f, 16.0f));
+		title->SetText("Probe " + std::to_string(panel));
+		container->AddChild(title);
+
+		for (int i = 0; i < kChartsPerPanel; ++i)
+		{
+			auto chart = std::make_shared<Sparkline>(static_cast<float>(panel * kChartsPerPanel + i) * 0.37f);
+			chart->SetBounds(Rect(panelX + static_cast<float>(i % 4) * 58.0f + 4.0f,
+			                      panelY + 20.0f + static_cast<float>(i / 4) * 24.0f, 54.0f, 22.0f));
+			container->AddChild(chart);
+			dashboard.charts.push_back(chart.get());
+		}
+		dashboard.window.AddChild(container);
+	}
+}
+
+// Every chart gets new data, as on a dashboard's refresh tick
+static void Tick(Dashboard& dashboard, int frame)
+{
+	for (size_t i = 0; i < dashboard.charts.size(); ++i)
+	{
+		dashboard.charts[i]->SetPhase(static_cast<float>(i) * 0.37f + static_cast<float>(frame) * 0.05f);
+	}
+}
+
+static bool SameFrame(const DrawList& a, const DrawList& b)
+{
+	const auto& ca = a.GetCommands();
+	const auto& cb = b.GetCommands();
+	if (ca.size() != cb.size())
+		return false;
+	for (size_t i = 0; i < ca.size(); ++i)
+	{
+		const DrawCommand& x = ca[i];
+		const DrawCommand& y = cb[i];
+		if (x.type != y.type || std::memcmp(&x.rect, &y.rect, sizeof(Rect)) != 0 ||
+		    std::memcmp(&x.color, &y.color, sizeof(Color)) != 0 || a.GetText(x) != b.GetText(y))
+			return false;
+	}
+	return true;
+}
+
+static bool SameDamage(const std::vector<DamageRect>& a, const std::vector<DamageRect>& b)
+{
+	return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(DamageRect)) == 0;
+}
+
+static void RunBenchmark()
+{
+	Dashboard serial;
+	BuildDashboard(serial);
+	serial.window.Render();
+
+	constexpr int kFrames = 20;
+	const double serialTime = MeasureMilliseconds([&] {
+		for (int frame = 0; frame < kFrames; ++frame)
+		{
+			Tick(serial, frame + 2);
+			serial.window.Render();
+		}
+	});
+
+	const int hardware = std::max(1u, std::thread::hardware_concurrency());
+	std::printf("%zu charts in %d panels, %d hardware threads:\n", serial.charts.size(), kPanels, hardware);
+	std::printf("  serial recording  : %7.3f ms per frame\n", serialTime / kFrames);
+
+	for (int threads : {1, 2, 4, 8, 16, 32})
+	{
+		ThreadPool pool(threads - 1);
+		Dashboard parallel;
+		BuildDashboard(parallel);
+		parallel.window.SetPaintPool(&pool);
+		parallel.backend.SetCapture(true);
+
+		// Both modes must send the backend the same commands and damage, for
+		// the first frame and after a tick
+		Dashboard reference;
+		BuildDashboard(reference);
+		reference.backend.SetCapture(true);
+		reference.window.Render();
+		parallel.window.Render();
+		bool identical = SameFrame(reference.backend.GetFrame(), parallel.backend.GetFrame()) &&
+		                 SameDamage(reference.backend.GetDamage(), parallel.backend.GetDamage());
+		Tick(reference, 1);
+		Tick(parallel, 1);
+		reference.window.Render();
+		parallel.window.Render();
+		identical = identical && SameFrame(reference.backend.GetFrame(), parallel.backend.GetFrame()) &&
+		            SameDamage(reference.backend.GetDamage(), parallel.backend.GetDamage());
+
+		parallel.backend.SetCapture(false);
+		const double time = MeasureMilliseconds([&] {
+			for (int frame = 0; frame < kFrames; ++frame)
+			{
+				Tick(parallel, frame + 2);
+				parallel.window.Render();
+			}
+		});
+		std::printf("  %2d thread(s)      : %7.3f ms per frame, speedup %.2fx, %s serial\n", threads, time / kFrames,
+		            serialTime / time, identical ? "identical to" : "DIFFERS from");
+	}
+}
+
+static constexpr int kDepth = 7;
+static constexpr int kFanOut = 4;
+
+// Containers nested kDepth levels, kFanOut children each, labels at the
+// bottom: the shape where copying subtrees into their parents costs most
+static void BuildDeepTree(Window& window, Widget& parent, const Rect& bounds, int depth,
+                          std::vector<Widget*>& containers, std::vector<Label*>& labels)
+{
+	for (int i = 0; i < kFanOut; ++i)
+	{
+		const float width = bounds.width / kFanOut;
+		const Rect child(bounds.x + width * static_cast<float>(i), bounds.y + 2.0f, width, bounds.height - 2.0f);
+		if (depth + 1 == kDepth)
+		{
+			Label* label = window.CreateWidget<Label>();
+			label->SetBounds(child);
+			label->SetText(std::to_string(labels.size() % 100));
+			parent.AddChild(label);
+			labels.push_back(label);
+		}
+		else
+		{
+			Widget* container = window.CreateWidget<Widget>();
+			container->SetBounds(child);
+			parent.AddChild(container);
+			containers.push_back(container);
+			BuildDeepTree(window, *container, child, depth + 1, containers, labels);
+		}
+	}
+}
+
+// The frame recorded from scratch, without any cached recording
+static void RecordReference(Widget& widget, DrawList& list)
+{
+	if (!widget.IsVisible())
+		return;
+	widget.OnPaint(list);
+	for (Widget* child : widget.GetChildren())
+	{
+		RecordReference(*child, list);
+	}
+}
+
+// Edits random widgets of a deep tree and checks after every frame that the
+// chained recordings draw exactly what a fresh recording would
+static bool RunRetainedCheck(ThreadPool* pool)
+{
+	CaptureBackend backend;
+	Window window;
+	window.Create("Deep Tree", 1920, 1080, &backend);
+	window.SetPaintPool(pool);
+	std::vector<Widget*> containers;
+	std::vector<Label*> labels;
+	BuildDeepTree(window, window, Rect(0.0f, 0.0f, 1920.0f, 1080.0f), 0, containers, labels);
+	window.Show();
+	backend.SetCapture(true);
+
+	std::mt19937 rng(7);
+	bool identical = true;
+	DrawList reference;
+	for (int frame = 0; frame < 200 && identical; ++frame)
+	{
+		for (int edit = 0; edit < 4; ++edit)
+		{
+			switch (rng() % 3)
+			{
+			case 0:
+				labels[rng() % labels.size()]->SetText(std::to_string(frame));
+				break;
+			case 1:
+			{
+				Widget* container = containers[rng() % containers.size()];
+				container->SetVisible(!container->IsVisible());
+				break;
+			}
+			default:
+			{
+				Label* label = labels[rng() % labels.size()];
+				Rect bounds = label->GetBounds();
+				bounds.y += 1.0f;
+				label->SetBounds(bounds);
+				break;
+			}
+			}
+		}
+		window.Render();
+
+		reference.Clear();
+		reference.AddClear(Color(0.2f, 0.2f, 0.2f, 1.0f));
+		RecordReference(window, reference);
+		identical = SameFrame(reference, backend.GetFrame());
+	}
+	std::printf("  %s recording: %s a fresh recording after 200 frames of random edits\n",
+	            pool ? "parallel" : "serial  ", identical ? "identical to" : "DIFFERS from");
+	return identical;
+}
+
+// One label changes per frame; only the path from the root to it is
+// re-recorded and relinked
+static void RunRetainedBenchmark()
+{
+	CaptureBackend backend;
+	Window window;
+	window.Create("Deep Tree", 1920, 1080, &backend);
+	std::vector<Widget*> containers;
+	std::vector<Label*> labels;
+	BuildDeepTree(window, window, Rect(0.0f, 0.0f, 1920.0f, 1080.0f), 0, containers, labels);
+	window.Show();
+	window.Render();
+
+	constexpr int kFrames = 1000;
+	const double time = MeasureMilliseconds([&] {
+		for (int frame = 0; frame < kFrames; ++frame)
+		{
+			labels[static_cast<size_t>(frame) * 7919 % labels.size()]->SetText(std::to_string(frame));
+			window.Render();
+		}
+	});
+	std::printf("%zu widgets nested %d deep:\n", containers.size() + labels.size() + 1, kDepth);
+	std::printf("  one label changed  : %7.4f ms per frame\n", time / kFrames);
+}
+
+int main()
+{
+	std::cout << "SnowUI Parallel Paint Demo" << std::endl;
+
+	RunBenchmark();
+	RunRetainedBenchmark();
+	bool retained = RunRetainedCheck(nullptr);
+	{
+		ThreadPool pool(3);
+		retained = RunRetainedCheck(&pool) && retained;
+	}
+
+	// Render the dashboard once on the software rasterizer with parallel
+	// recording, as a headless render node would
+	ThreadPool pool;
+	SoftwareBackend backend;
+	Window window;
+	if (!window.Create("Parallel Paint Demo", 1920, 1080, &backend))
+	{
+		std::cerr << "Failed to create window" << std::endl;
+		return 1;
+	}
+	window.SetPaintPool(&pool);
+	for (int panel = 0; panel < kPanels; ++panel)
+	{
+		auto chart = std::make_shared<Sparkline>(static_cast<float>(panel));
+		chart->SetBounds(Rect(static_cast<float>(panel % 8) * 240.0f, static_cast<float>(panel / 8) * 270.0f, 236.0f,
+		                      266.0f));
+		window.AddChild(chart);
+	}
+	window.Show();
+	window.Render();
+	std::cout << "Rendered " << window.GetLastFrameStats().pixelsRedrawn << " pixels" << std::endl;
+
+	std::cout << (retained ? "Demo completed successfully!" : "Demo completed with failures") << std::endl;
+
+	return retained ? 0 : 1;
+}
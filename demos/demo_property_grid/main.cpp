@@ -1,15 +1,184 @@
+#include "SnowUI/Core/ThreadPool.h"
 #include "SnowUI/Core/Window.h"
 #include "SnowUI/Widgets/PropertyGrid.h"
 #include "SnowUI/Render/OpenGLBackend.h"
+#include "SnowUI/Render/SoftwareBackend.h"
+#include "SnowUI/Render/TextLayout.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace SnowUI;
 
+static constexpr size_t kRows = 100000;
+
+template <typename F> static double MeasureMilliseconds(F&& f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int g_failures = 0;
+
+static void Check(bool condition, const char* what)
+{
+	if (!condition)
+	{
+		std::printf("  FAILED: %s\n", what);
+		g_failures++;
+	}
+}
+
+// Solver output names: one row per layer and parameter
+static std::vector<std::string> MakeNames()
+{
+	static const char* const kParameters[] = {"Cohesion", "Friction Angle", "Unit Weight", "Pore Pressure",
+	                                          "Young Modulus"};
+	std::vector<std::string> names;
+	names.reserve(kRows);
+	for (size_t i = 0; i < kRows; ++i)
+	{
+		names.push_back("Layer " + std::to_string(i / 5) + " " + kParameters[i % 5]);
+	}
+	return names;
+}
+
+// Cached measurements must equal freshly computed ones, whichever shard
+// holds them, and a full cache must stay within its capacity
+static void CheckMeasureCache(const std::vector<std::string>& names)
+{
+	TextMeasureCache& cache = TextMeasureCache::Instance();
+	cache.Clear();
+	std::vector<float> widths;
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		widths.push_back(MeasureText(names[i]).width);
+	}
+	const TextMeasureStats stats = cache.GetStats();
+	bool same = true;
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		same = same && MeasureText(names[i]).width == widths[i];
+	}
+	Check(same, "cached widths match computed widths");
+	Check(cache.GetStats().hits == stats.hits + 2000, "repeated strings are cache hits");
+
+	cache.SetCapacity(256);
+	for (size_t i = 0; i < 5000; ++i)
+	{
+		MeasureText(names[i]);
+	}
+	Check(cache.GetStats().entryCount <= 256, "cache stays within its capacity");
+	same = true;
+	for (size_t i = 0; i < 2000; ++i)
+	{
+		same = same && MeasureText(names[i]).width == widths[i];
+	}
+	Check(same, "widths survive flushes");
+	cache.SetCapacity(1 << 18);
+
+	std::printf("Measure cache check: %s\n", g_failures == 0 ? "passed" : "FAILED");
+}
+
+// Measures every name from threads threads at once; with oneLock set every
+// call is serialized the way a single cache mutex serializes them
+static double MeasureInParallel(const std::vector<std::string>& names, int threads, bool oneLock)
+{
+	ThreadPool pool(threads - 1);
+	std::mutex lock;
+	return MeasureMilliseconds([&] {
+		pool.ParallelFor(static_cast<size_t>(threads), [&](size_t thread) {
+			for (size_t i = thread; i < names.size(); i += static_cast<size_t>(threads))
+			{
+				if (oneLock)
+				{
+					std::lock_guard<std::mutex> guard(lock);
+					MeasureText(names[i]);
+				}
+				else
+				{
+					MeasureText(names[i]);
+				}
+			}
+		});
+	});
+}
+
+static void RunBenchmark(const std::vector<std::string>& names)
+{
+	TextMeasureCache::Instance().Clear();
+
+	// Loading measures each new name once
+	auto grid = std::make_shared<PropertyGrid>();
+	grid->SetBounds(Rect(0.0f, 0.0f, 800.0f, 600.0f));
+	const double load = MeasureMilliseconds([&] {
+		grid->Reserve(kRows);
+		for (size_t i = 0; i < kRows; ++i)
+		{
+			grid->AddProperty(names[i], PropertyValue::Float(static_cast<double>(i) * 0.5));
+		}
+	});
+
+	SoftwareBackend backend(1);
+	Window window;
+	window.Create("Property Grid Benchmark", 800, 600, &backend);
+	window.AddChild(grid);
+	window.Show();
+	window.Render();
+
+	constexpr int kFrames = 100;
+	const double scroll = MeasureMilliseconds([&] {
+		for (int frame = 0; frame < kFrames; ++frame)
+		{
+			grid->SetScrollOffset(grid->GetMaxScrollOffset() * frame / kFrames);
+			window.Render();
+		}
+	});
+
+	std::vector<PropertyUpdate> updates;
+	for (size_t i = 0; i < kRows; i += 10)
+	{
+		updates.push_back({static_cast<PropertyId>(i), PropertyValue::Float(static_cast<double>(i) * 0.25)});
+	}
+	const double update = MeasureMilliseconds([&] {
+		grid->SetValues(updates);
+		window.Render();
+	});
+
+	std::printf("%zu-row property grid:\n", grid->GetPropertyCount());
+	std::printf("  load                 : %8.2f ms\n", load);
+	std::printf("  scroll frame         : %8.3f ms\n", scroll / kFrames);
+	std::printf("  update %6zu values : %8.3f ms, frame included\n", updates.size(), update);
+
+	// Measuring row labels from paint threads, cold and then warm
+	const int hardware = std::max(1u, std::thread::hardware_concurrency());
+	std::printf("Measuring %zu labels, %d hardware threads:\n", names.size(), hardware);
+	for (int threads = 1; threads <= std::max(hardware, 4); threads *= 2)
+	{
+		TextMeasureCache::Instance().Clear();
+		const double cold = MeasureInParallel(names, threads, false);
+		const double warm = MeasureInParallel(names, threads, false);
+		const double locked = MeasureInParallel(names, threads, true);
+		std::printf("  %2d thread(s): cold %7.2f ms, warm %7.2f ms, warm under one lock %7.2f ms\n", threads, cold,
+		            warm, locked);
+	}
+}
+
 int main()
 {
 	std::cout << "SnowUI Property Grid Demo" << std::endl;
 
+	const std::vector<std::string> names = MakeNames();
+	CheckMeasureCache(names);
+	RunBenchmark(names);
+
 	// Create OpenGL backend
 	OpenGLBackend backend;
 
@@ -26,12 +195,12 @@ int main()
 	propertyGrid->SetBounds(Rect(10, 10, 780, 580));
 
 	// Add sample properties
-	propertyGrid->AddProperty("Name", "Demo Project", "string");
-	propertyGrid->AddProperty("Version", "1.0.0", "string");
-	propertyGrid->AddProperty("Width", "800", "int");
-	propertyGrid->AddProperty("Height", "600", "int");
-	propertyGrid->AddProperty("Enabled", "true", "bool");
-	propertyGrid->AddProperty("BackColor", "#202020", "color");
+	propertyGrid->AddProperty("Name", PropertyValue::String("Demo Project"));
+	propertyGrid->AddProperty("Version", PropertyValue::String("1.0.0"));
+	propertyGrid->AddProperty("Width", PropertyValue::Int(800));
+	propertyGrid->AddProperty("Height", PropertyValue::Int(600));
+	propertyGrid->AddProperty("Enabled", PropertyValue::Bool(true));
+	propertyGrid->AddProperty("BackColor", PropertyValue::FromColor(0x202020FF));
 
 	window->AddChild(propertyGrid);
 
@@ -39,7 +208,7 @@ int main()
 	std::cout << "Running property grid window (close window to exit)..." << std::endl;
 	window->Run();
 
-	std::cout << "Demo completed successfully!" << std::endl;
+	std::cout << (g_failures == 0 ? "Demo completed successfully!" : "Demo completed with failures") << std::endl;
 
-	return 0;
+	return g_failures == 0 ? 0 : 1;
 }
@@ -0,0 +1,228 @@
+#include "SnowUI/Core/Window.h"
+#include "SnowUI/Widgets/Label.h"
+#include "SnowUI/Render/OpenGLBackend.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace SnowUI;
+
+static constexpr auto kRefreshPeriod = std::chrono::microseconds(16667);
+static constexpr auto kInputDuration = std::chrono::seconds(2);
+static constexpr auto kInputPeriod = std::chrono::microseconds(1000);
+
+// Headless stand-in for a windowed GPU backend: EndFrame() blocks until
+// the next 60 Hz vblank as a vsynced swap does, and WaitEvents() sleeps
+// until PostEmptyEvent() like the platform's event wait.
+class VsyncBackend : public IRenderBackend
+{
+  public:
+	bool Initialize(int width, int height) override
+	{
+		(void)width;
+		(void)height;
+		vblank_ = std::chrono::steady_clock::now();
+		return true;
+	}
+	void Shutdown() override
+	{
+	}
+	void BeginFrame() override
+	{
+	}
+	void EndFrame() override
+	{
+		const auto now = std::chrono::steady_clock::now();
+		while (vblank_ <= now)
+		{
+			vblank_ += kRefreshPeriod;
+		}
+		std::this_thread::sleep_until(vblank_);
+
+		if (lastPresent_.time_since_epoch().count() != 0)
+		{
+			const auto interval = std::chrono::duration_cast<std::chrono::microseconds>(vblank_ - lastPresent_);
+			presentIntervals_.Add(static_cast<uint64_t>(interval.count()));
+		}
+		lastPresent_ = vblank_;
+	}
+	void ExecuteDrawList(const DrawList& drawList) override
+	{
+		commands_ += drawList.GetCommands().size();
+	}
+	void Resize(int width, int height) override
+	{
+		(void)width;
+		(void)height;
+	}
+
+	bool CreateWindow(const std::string& title, int width, int height) override
+	{
+		(void)title;
+		(void)width;
+		(void)height;
+		return true;
+	}
+	bool ShouldClose() override
+	{
+		return false;
+	}
+	bool WaitEvents(double timeoutSeconds) override
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		const auto woken = [this] { return woken_; };
+		if (timeoutSeconds < 0.0)
+			wake_.wait(lock, woken);
+		else
+			wake_.wait_for(lock, std::chrono::duration<double>(timeoutSeconds), woken);
+		woken_ = false;
+		return false;
+	}
+	void PostEmptyEvent() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			woken_ = true;
+		}
+		wake_.notify_one();
+	}
+
+	const TimeHistogram& GetPresentIntervals() const
+	{
+		return presentIntervals_;
+	}
+
+  private:
+	std::chrono::steady_clock::time_point vblank_;
+	std::chrono::steady_clock::time_point lastPresent_;
+	TimeHistogram presentIntervals_;
+	size_t commands_ = 0;
+
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	bool woken_ = false;
+};
+
+// Full-window canvas whose marker follows the mouse, over a grid of labels
+// that gives each frame some recording and copying to do
+class Canvas : public Widget
+{
+  public:
+	Canvas()
+	{
+		for (int i = 0; i < 600; ++i)
+		{
+			auto label = std::make_shared<Label>();
+			label->SetBounds(Rect(static_cast<float>(i % 20) * 64.0f, static_cast<float>(i / 20) * 24.0f, 60.0f, 20.0f));
+			label->SetText("Cell " + std::to_string(i));
+			AddChild(label);
+		}
+		marker_ = std::make_shared<Widget>();
+		marker_->SetBounds(Rect(0, 0, 8, 8));
+		AddChild(marker_);
+	}
+
+	void OnEvent(const Event& event) override
+	{
+		if (event.type == EventType::MouseMove)
+			marker_->SetBounds(Rect(static_cast<float>(event.x), static_cast<float>(event.y), 8, 8));
+	}
+
+  private:
+	std::shared_ptr<Widget> marker_;
+};
+
+static void PrintHistogram(const char* name, const TimeHistogram& histogram)
+{
+	std::printf("  %s: %llu samples, p50 < %llu us, p99 < %llu us\n", name,
+	            static_cast<unsigned long long>(histogram.total),
+	            static_cast<unsigned long long>(histogram.GetPercentile(0.5)),
+	            static_cast<unsigned long long>(histogram.GetPercentile(0.99)));
+	for (int i = 0; i < TimeHistogram::kBuckets; ++i)
+	{
+		if (histogram.counts[i] == 0)
+			continue;
+		const int bar = static_cast<int>(histogram.counts[i] * 40 / histogram.total);
+		std::printf("    %6llu - %6llu us %6llu %s\n", i ? 1ull << i : 0ull, 2ull << i,
+		            static_cast<unsigned long long>(histogram.counts[i]), std::string(bar, '#').c_str());
+	}
+}
+
+// Moves the mouse at 1000 Hz for two seconds while the window runs, then
+// reports how long input waited and how long frames held the UI thread
+static void RunScenario(bool renderThread)
+{
+	std::printf("%s:\n", renderThread ? "Render thread" : "Rendering on the UI thread");
+
+	VsyncBackend backend;
+	Window window;
+	window.Create("Render Thread Benchmark", 1280, 720, &backend);
+	window.AddChild(std::make_shared<Canvas>());
+	window.SetRenderThread(renderThread);
+
+	std::thread input([&window] {
+		const auto start = std::chrono::steady_clock::now();
+		auto next = start;
+		for (int i = 0; std::chrono::steady_clock::now() - start < kInputDuration; ++i)
+		{
+			Event move;
+			move.type = EventType::MouseMove;
+			move.x = 100 + i % 1000;
+			move.y = 100 + (i / 7) % 500;
+			window.QueueEvent(move);
+
+			next += kInputPeriod;
+			std::this_thread::sleep_until(next);
+		}
+		window.Post([&window] { window.Close(); });
+	});
+
+	window.Run();
+	input.join();
+	const RenderThreadStats stats = window.GetRenderThreadStats();
+	window.SetRenderThread(false); // the backend's stats are the render thread's until it stops
+
+	const EventQueueStats events = window.GetEventQueue().GetStats();
+	std::printf("  %llu mouse reports dispatched as %llu events\n", static_cast<unsigned long long>(events.pushed),
+	            static_cast<unsigned long long>(events.delivered));
+	PrintHistogram("input latency", events.latency);
+	PrintHistogram("UI thread time per frame", window.GetFrameTimes());
+	PrintHistogram("present interval", backend.GetPresentIntervals());
+	if (renderThread)
+	{
+		std::printf("  %llu frames published, %llu presented, %llu replaced before they were drawn\n",
+		            static_cast<unsigned long long>(stats.published), static_cast<unsigned long long>(stats.presented),
+		            static_cast<unsigned long long>(stats.dropped));
+	}
+}
+
+int main()
+{
+	std::cout << "SnowUI Render Thread Demo" << std::endl;
+
+	RunScenario(false);
+	RunScenario(true);
+
+	OpenGLBackend backend;
+	auto window = std::make_shared<Window>();
+	if (!window->Create("Render Thread Demo", 1280, 720, &backend))
+	{
+		std::cerr << "Failed to create window" << std::endl;
+		return 1;
+	}
+	window->AddChild(std::make_shared<Canvas>());
+	window->SetRenderThread(true);
+
+	std::cout << "Running render thread window (move the mouse; close window to exit)..." << std::endl;
+	window->Run();
+
+	std::cout << "Demo completed successfully!" << std::endl;
+
+	return 0;
+}
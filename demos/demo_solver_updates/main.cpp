@@ -0,0 +1,374 @@
+#include "SnowUI/Core/Window.h"
+#include "SnowUI/Widgets/PropertyGrid.h"
+#include "SnowUI/Render/OpenGLBackend.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SnowUI;
+
+static constexpr int kSolvers = 2;
+static constexpr int kProbes = 64;
+static constexpr auto kSolveDuration = std::chrono::seconds(1);
+static constexpr auto kRefreshPeriod = std::chrono::microseconds(16667);
+
+static int g_failures = 0;
+
+static void Check(bool condition, const char* what)
+{
+	if (!condition)
+	{
+		std::printf("  FAILED: %s\n", what);
+		g_failures++;
+	}
+}
+
+template <typename F> static double MeasureMilliseconds(F&& f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Headless stand-in for a windowed backend: a 60 Hz vsynced swap and an
+// event wait that PostEmptyEvent() ends
+class FrameBackend : public IRenderBackend
+{
+  public:
+	bool Initialize(int width, int height) override
+	{
+		(void)width;
+		(void)height;
+		return true;
+	}
+	void Shutdown() override
+	{
+	}
+	void BeginFrame() override
+	{
+	}
+	void EndFrame() override
+	{
+		std::this_thread::sleep_for(kRefreshPeriod);
+	}
+	void ExecuteDrawList(const DrawList& drawList) override
+	{
+		(void)drawList;
+	}
+	void Resize(int width, int height) override
+	{
+		(void)width;
+		(void)height;
+	}
+
+	bool CreateWindow(const std::string& title, int width, int height) override
+	{
+		(void)title;
+		(void)width;
+		(void)height;
+		return true;
+	}
+	bool ShouldClose() override
+	{
+		return false;
+	}
+	bool WaitEvents(double timeoutSeconds) override
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		const auto woken = [this] { return woken_; };
+		if (timeoutSeconds < 0.0)
+			wake_.wait(lock, woken);
+		else
+			wake_.wait_for(lock, std::chrono::duration<double>(timeoutSeconds), woken);
+		woken_ = false;
+		return false;
+	}
+	void PostEmptyEvent() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			woken_ = true;
+		}
+		wake_.notify_one();
+	}
+
+  private:
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	bool woken_ = false;
+};
+
+enum class Mode
+{
+	Unbounded, // every post runs, all of them each iteration
+	Budget,	   // every post runs, 4 ms of them per iteration
+	Keyed,	   // 4 ms per iteration, updates of one property coalesce
+};
+
+// Solver threads stream residuals and probe values into a property grid
+// while the mouse moves at 1000 Hz; reports what the UI thread ran and how
+// long input waited behind it
+static void RunScenario(Mode mode, const char* name)
+{
+	FrameBackend backend;
+	Window window;
+	window.Create("Solver Updates", 1280, 720, &backend);
+	window.SetPostBudget(mode == Mode::Unbounded ? std::chrono::hours(1) : std::chrono::milliseconds(4));
+
+	auto grid = std::make_shared<PropertyGrid>();
+	grid->SetBounds(Rect(0, 0, 1280, 720));
+	std::vector<PropertyId> residuals;
+	for (int solver = 0; solver < kSolvers; ++solver)
+	{
+		residuals.push_back(grid->AddProperty("Residual " + std::to_string(solver), PropertyValue::Float(1.0)));
+	}
+	std::vector<PropertyId> probes;
+	for (int probe = 0; probe < kProbes; ++probe)
+	{
+		probes.push_back(grid->AddProperty("Probe " + std::to_string(probe), PropertyValue::Float(0.0)));
+	}
+	PropertyGrid* target = grid.get();
+	window.AddChild(grid);
+
+	const auto post = [&window, mode](PropertyId id, std::function<void()> task) {
+		if (mode == Mode::Keyed)
+			window.Post(static_cast<PostKey>(id) + 1, std::move(task));
+		else
+			window.Post(std::move(task));
+	};
+
+	std::atomic<int> running(kSolvers);
+	std::vector<double> finalResiduals(kSolvers);
+	std::vector<std::thread> solvers;
+	for (int solver = 0; solver < kSolvers; ++solver)
+	{
+		solvers.emplace_back([&, solver] {
+			const auto start = std::chrono::steady_clock::now();
+			double residual = 1.0;
+			for (uint64_t step = 0; std::chrono::steady_clock::now() - start < kSolveDuration; ++step)
+			{
+				residual *= 0.999999;
+				const PropertyId id = residuals[solver];
+				post(id, [target, id, residual] { target->SetValue(id, PropertyValue::Float(residual)); });
+				if (step % 16 == 0)
+				{
+					const PropertyId probe = probes[(step / 16 + solver) % kProbes];
+					const double value = std::sin(static_cast<double>(step) * 1e-4);
+					post(probe, [target, probe, value] { target->SetValue(probe, PropertyValue::Float(value)); });
+				}
+			}
+			finalResiduals[solver] = residual;
+			if (running.fetch_sub(1) == 1)
+				window.Post([&window] { window.Close(); });
+		});
+	}
+
+	std::atomic<bool> moving(true);
+	std::thread input([&window, &moving] {
+		auto next = std::chrono::steady_clock::now();
+		for (int i = 0; moving.load(); ++i)
+		{
+			Event move;
+			move.type = EventType::MouseMove;
+			move.x = 100 + i % 1000;
+			move.y = 100;
+			window.QueueEvent(move);
+			next += std::chrono::milliseconds(1);
+			std::this_thread::sleep_until(next);
+		}
+	});
+
+	const double elapsed = MeasureMilliseconds([&] { window.Run(); });
+	moving = false;
+	input.join();
+	for (auto& solver : solvers)
+	{
+		solver.join();
+	}
+
+	// Close() runs after everything posted before it, so the grid must show
+	// each solver's last residual
+	bool current = true;
+	for (int solver = 0; solver < kSolvers; ++solver)
+	{
+		current = current && target->GetValue(residuals[solver]).floatValue == finalResiduals[solver];
+	}
+
+	const PostQueueStats posts = window.GetPostStats();
+	const EventQueueStats events = window.GetEventQueue().GetStats();
+	std::printf("%s:\n", name);
+	std::printf("  %llu posts, %llu coalesced, %llu run; drained %.0f ms after the solvers started\n",
+	            static_cast<unsigned long long>(posts.received), static_cast<unsigned long long>(posts.coalesced),
+	            static_cast<unsigned long long>(posts.run), elapsed);
+	std::printf("  input latency p50 < %llu us, p99 < %llu us, max %llu us; residuals %s\n",
+	            static_cast<unsigned long long>(events.latency.GetPercentile(0.5)),
+	            static_cast<unsigned long long>(events.latency.GetPercentile(0.99)),
+	            static_cast<unsigned long long>(events.maxLatencyUs), current ? "current" : "STALE");
+	Check(current, "the grid shows each solver's last residual");
+	Check(posts.keySlotsInUse == 0, "drained keys give their slots back");
+}
+
+// Short-lived keys, e.g. one per transient object, far more of them over
+// time than there are key slots. Each key must still end on its latest
+// task, and once drained every slot must be free for the keys that follow.
+static void RunKeyChurn()
+{
+	constexpr size_t kKeys = 256 * 1024;
+	constexpr size_t kKeysPerBurst = 512;
+	constexpr int kRepeats = 8;
+	constexpr int kPosters = 2;
+
+	PostQueue queue;
+	std::vector<int> lastRun(kKeys, -1);
+	std::atomic<int> posting(kPosters);
+	const double elapsed = MeasureMilliseconds([&] {
+		std::vector<std::thread> posters;
+		for (int poster = 0; poster < kPosters; ++poster)
+		{
+			// Each key belongs to one poster, so its latest task is well defined
+			posters.emplace_back([&, poster] {
+				for (size_t burst = poster * kKeysPerBurst; burst < kKeys; burst += kPosters * kKeysPerBurst)
+				{
+					for (int repeat = 0; repeat < kRepeats; ++repeat)
+					{
+						for (size_t key = burst; key < burst + kKeysPerBurst; ++key)
+						{
+							queue.Push(static_cast<PostKey>(key) + 1,
+							           [&lastRun, key, repeat] { lastRun[key] = repeat; });
+						}
+					}
+				}
+				posting.fetch_sub(1);
+			});
+		}
+		// The UI thread's side: drain while the posters run, then the rest
+		while (posting.load() > 0 || queue.HasBacklog())
+		{
+			queue.Run(std::chrono::milliseconds(4));
+		}
+		for (auto& poster : posters)
+		{
+			poster.join();
+		}
+		queue.Run(std::chrono::hours(1));
+	});
+
+	size_t stale = 0;
+	for (int value : lastRun)
+	{
+		stale += value != kRepeats - 1;
+	}
+	const PostQueueStats stats = queue.GetStats();
+	std::printf("Key churn, %zu keys through %zu key slots:\n", kKeys, PostQueue::kKeySlots);
+	std::printf("  %llu posts, %llu coalesced, %llu run in %.0f ms; %zu keys stale, %zu slots in use after draining\n",
+	            static_cast<unsigned long long>(stats.received), static_cast<unsigned long long>(stats.coalesced),
+	            static_cast<unsigned long long>(stats.run), elapsed, stale, stats.keySlotsInUse);
+	Check(stale == 0, "every key ends on its latest task");
+	Check(stats.received == stats.coalesced + stats.run, "every post is run or coalesced");
+	Check(stats.keySlotsInUse == 0, "drained keys give their slots back");
+}
+
+// Posting throughput against a mutex-guarded vector, as Post used before
+static void RunPushBenchmark()
+{
+	constexpr int kPushes = 200000;
+	const int hardware = std::max(1u, std::thread::hardware_concurrency());
+	std::printf("Push throughput, %d posts per thread (%d hardware threads):\n", kPushes, hardware);
+	for (int threads = 1; threads <= 4; threads *= 2)
+	{
+		PostQueue queue;
+		const double lockFree = MeasureMilliseconds([&] {
+			std::vector<std::thread> posters;
+			for (int t = 0; t < threads; ++t)
+			{
+				posters.emplace_back([&queue] {
+					for (int i = 0; i < kPushes; ++i)
+					{
+						queue.Push(kNoPostKey, [] {});
+					}
+				});
+			}
+			for (auto& poster : posters)
+			{
+				poster.join();
+			}
+		});
+
+		std::mutex mutex;
+		std::vector<std::function<void()>> tasks;
+		const double locked = MeasureMilliseconds([&] {
+			std::vector<std::thread> posters;
+			for (int t = 0; t < threads; ++t)
+			{
+				posters.emplace_back([&] {
+					for (int i = 0; i < kPushes; ++i)
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						tasks.push_back([] {});
+					}
+				});
+			}
+			for (auto& poster : posters)
+			{
+				poster.join();
+			}
+		});
+
+		const double total = static_cast<double>(kPushes) * threads;
+		std::printf("  %d thread(s): lock-free %6.1f ns per post, mutex %6.1f ns per post\n", threads,
+		            lockFree * 1e6 / total, locked * 1e6 / total);
+	}
+}
+
+int main()
+{
+	std::cout << "SnowUI Solver Updates Demo" << std::endl;
+
+	RunPushBenchmark();
+	RunScenario(Mode::Unbounded, "Every post, no budget");
+	RunScenario(Mode::Budget, "Every post, 4 ms budget");
+	RunScenario(Mode::Keyed, "Keyed posts, 4 ms budget");
+	RunKeyChurn();
+
+	OpenGLBackend backend;
+	auto window = std::make_shared<Window>();
+	if (!window->Create("Solver Updates Demo", 800, 600, &backend))
+	{
+		std::cerr << "Failed to create window" << std::endl;
+		return 1;
+	}
+	auto grid = std::make_shared<PropertyGrid>();
+	grid->SetBounds(Rect(10, 10, 780, 580));
+	const PropertyId residual = grid->AddProperty("Residual", PropertyValue::Float(1.0));
+	window->AddChild(grid);
+
+	std::atomic<bool> solving(true);
+	PropertyGrid* target = grid.get();
+	std::thread solver([&] {
+		double value = 1.0;
+		while (solving.load())
+		{
+			value *= 0.999999;
+			window->Post(static_cast<PostKey>(residual) + 1,
+			             [target, residual, value] { target->SetValue(residual, PropertyValue::Float(value)); });
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+	});
+
+	std::cout << "Running solver window (close window to exit)..." << std::endl;
+	window->Run();
+	solving = false;
+	solver.join();
+
+	std::cout << (g_failures == 0 ? "Demo completed successfully!" : "Demo completed with failures") << std::endl;
+
+	return g_failures == 0 ? 0 : 1;
+}
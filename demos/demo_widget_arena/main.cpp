@@ -0,0 +1,302 @@
+#include "SnowUI/Core/Window.h"
+#include "SnowUI/Widgets/Label.h"
+#include "SnowUI/Render/OpenGLBackend.h"
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SnowUI;
+
+static constexpr int kPanels = 1000;
+static constexpr int kLabelsPerPanel = 99; // 100k widgets with the panels
+
+template <typename F> static double MeasureMilliseconds(F&& f)
+{
+	const auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static int g_failures = 0;
+
+static void Check(bool condition, const char* what)
+{
+	if (!condition)
+	{
+		std::printf("  FAILED: %s\n", what);
+		g_failures++;
+	}
+}
+
+static Rect GetPanelBounds(int panel)
+{
+	return Rect(static_cast<float>(panel % 40) * 32.0f, static_cast<float>(panel / 40) * 40.0f, 30.0f, 38.0f);
+}
+
+static Rect GetLabelBounds(const Rect& panel, int label)
+{
+	return Rect(panel.x + static_cast<float>(label % 3) * 10.0f, panel.y + static_cast<float>(label / 3), 10.0f, 12.0f);
+}
+
+// Builds the dialog with shared_ptr-owned widgets, the default layout
+static void BuildShared(Window& window)
+{
+	for (int panel = 0; panel < kPanels; ++panel)
+	{
+		auto container = std::make_shared<Widget>();
+		container->SetBounds(GetPanelBounds(panel));
+		for (int label = 0; label < kLabelsPerPanel; ++label)
+		{
+			auto child = std::make_shared<Label>();
+			child->SetBounds(GetLabelBounds(container->GetBounds(), label));
+			child->SetText(std::to_string(label));
+			container->AddChild(child);
+		}
+		window.AddChild(container);
+	}
+}
+
+// Builds the same dialog with widgets owned by the window's arena
+static void BuildArena(Window& window)
+{
+	for (int panel = 0; panel < kPanels; ++panel)
+	{
+		Widget* container = window.CreateWidget<Widget>();
+		container->SetBounds(GetPanelBounds(panel));
+		for (int label = 0; label < kLabelsPerPanel; ++label)
+		{
+			Label* child = window.CreateWidget<Label>();
+			child->SetBounds(GetLabelBounds(container->GetBounds(), label));
+			child->SetText(std::to_string(label));
+			container->AddChild(child);
+		}
+		window.AddChild(container);
+	}
+}
+
+template <typename Build> static void RunBenchmark(const char* name, Build&& build)
+{
+	auto window = std::make_unique<Window>();
+	window->Create(name, 1280, 1024, nullptr);
+	window->Show();
+
+	DrawList drawList;
+	const double construction = MeasureMilliseconds([&] { build(*window); });
+	const double firstPaint = MeasureMilliseconds([&] { window->Paint(drawList); });
+
+	// Re-record every widget, so the traversal and OnPaint calls dominate
+	const double repaint = MeasureMilliseconds([&] {
+		for (Widget* panel : window->GetChildren())
+		{
+			for (Widget* child : panel->GetChildren())
+			{
+				child->Invalidate();
+			}
+		}
+		drawList.Clear();
+		window->Paint(drawList);
+	});
+
+	const double teardown = MeasureMilliseconds([&] { window.reset(); });
+	std::printf("  %-8s construct %7.2f ms   first paint %7.2f ms   full repaint %7.2f ms   teardown %7.2f ms\n", name,
+	            construction, firstPaint, repaint, teardown);
+}
+
+// Topmost widget at (x, y) found by walking the whole tree in paint order,
+// the way events were routed before the hit-test grid
+static Widget* FindTopmostBelow(Widget& widget, float x, float y)
+{
+	Widget* topmost = nullptr;
+	for (Widget* child : widget.GetChildren())
+	{
+		if (!child->IsVisible())
+			continue;
+		const Rect& bounds = child->GetBounds();
+		if (x >= bounds.x && x <= bounds.x + bounds.width && y >= bounds.y && y <= bounds.y + bounds.height)
+			topmost = child;
+		if (Widget* hit = FindTopmostBelow(*child, x, y))
+			topmost = hit;
+	}
+	return topmost;
+}
+
+// Widgets reaching past the window are only hit on its surface
+static Widget* FindTopmost(Window& window, float x, float y)
+{
+	const Rect& surface = window.GetBounds();
+	if (x < 0.0f || y < 0.0f || x >= surface.width || y >= surface.height)
+		return nullptr;
+	return FindTopmostBelow(window, x, y);
+}
+
+// Counts the mouse events that reach a widget as their target
+class CountingWidget : public Widget
+{
+  public:
+	void OnEvent(const Event& event) override
+	{
+		if (event.phase == EventPhase::Target)
+			targeted_++;
+	}
+
+	size_t GetTargeted() const
+	{
+		return targeted_;
+	}
+
+  private:
+	size_t targeted_ = 0;
+};
+
+// Random points over the window and just outside it, plus points on widget
+// edges, where an off-by-one in the cell range would show
+static std::vector<std::pair<float, float>> MakePoints(size_t count)
+{
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> px(-16.0f, 1296.0f);
+	std::uniform_real_distribution<float> py(-16.0f, 1040.0f);
+	std::vector<std::pair<float, float>> points;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (i % 4 == 0)
+			points.emplace_back(static_cast<float>(rng() % 1281), static_cast<float>(rng() % 1025));
+		else
+			points.emplace_back(px(rng), py(rng));
+	}
+	return points;
+}
+
+// Builds the 100k-widget dialog, then hides, moves and overlays widgets so
+// every index path is exercised, and compares the grid with the tree walk
+static void RunHitTestBenchmark()
+{
+	Window window;
+	window.Create("Hit Test", 1280, 1024, nullptr);
+	window.Show();
+	BuildArena(window);
+
+	// A hidden panel hides its labels; a moved label leaves and enters cells
+	const std::vector<Widget*> panels = window.GetChildren();
+	for (size_t panel = 0; panel < panels.size(); ++panel)
+	{
+		const std::vector<Widget*>& labels = panels[panel]->GetChildren();
+		if (panel % 13 == 0)
+			panels[panel]->SetVisible(false);
+		labels[panel % labels.size()]->SetVisible(false);
+		const Rect moved = GetPanelBounds(static_cast<int>((panel * 7) % panels.size()));
+		labels[(panel + 1) % labels.size()]->SetBounds(Rect(moved.x + 5.0f, moved.y + 20.0f, 40.0f, 30.0f));
+	}
+
+	// Large widgets go to the grid's separate list: one on top, one hidden,
+	// and one under a panel's child that draws above it
+	Widget* overlay = window.CreateWidget<Widget>();
+	overlay->SetBounds(Rect(800.0f, 600.0f, 600.0f, 600.0f));
+	window.AddChild(overlay);
+	Widget* hiddenOverlay = window.CreateWidget<Widget>();
+	hiddenOverlay->SetBounds(Rect(0.0f, 0.0f, 1280.0f, 1024.0f));
+	hiddenOverlay->SetVisible(false);
+	window.AddChild(hiddenOverlay);
+	Widget* backdrop = window.CreateWidget<Widget>();
+	backdrop->SetBounds(Rect(0.0f, 0.0f, 700.0f, 700.0f));
+	panels[5]->AddChild(backdrop);
+	CountingWidget* target = window.CreateWidget<CountingWidget>();
+	target->SetBounds(GetLabelBounds(panels[5]->GetBounds(), 0));
+	panels[5]->AddChild(target);
+
+	const std::vector<std::pair<float, float>> points = MakePoints(20000);
+	size_t mismatches = 0;
+	for (const auto& point : points)
+	{
+		mismatches += window.HitTest(point.first, point.second) != FindTopmost(window, point.first, point.second);
+	}
+	std::printf("Hit test check: %zu mismatches against a tree walk over %zu points\n", mismatches, points.size());
+	Check(mismatches == 0, "grid hit test matches the topmost widget in paint order");
+
+	const size_t kQueries = points.size();
+	size_t sink = 0;
+	const double grid = MeasureMilliseconds([&] {
+		for (const auto& point : points)
+		{
+			sink += window.HitTest(point.first, point.second) != nullptr;
+		}
+	});
+	const double walk = MeasureMilliseconds([&] {
+		for (size_t i = 0; i < kQueries / 20; ++i)
+		{
+			sink += FindTopmost(window, points[i].first, points[i].second) != nullptr;
+		}
+	});
+
+	// Full routing of mouse moves and clicks, capture and bubble included
+	Event move;
+	move.type = EventType::MouseMove;
+	const double moves = MeasureMilliseconds([&] {
+		for (const auto& point : points)
+		{
+			move.x = static_cast<int>(point.first);
+			move.y = static_cast<int>(point.second);
+			window.DispatchEvent(move);
+		}
+	});
+	const Rect& targetBounds = target->GetBounds();
+	Event click;
+	click.x = static_cast<int>(targetBounds.x + 2.0f);
+	click.y = static_cast<int>(targetBounds.y + 2.0f);
+	const double clicks = MeasureMilliseconds([&] {
+		for (size_t i = 0; i < kQueries / 2; ++i)
+		{
+			click.type = EventType::MouseDown;
+			window.DispatchEvent(click);
+			click.type = EventType::MouseUp;
+			window.DispatchEvent(click);
+		}
+	});
+	Check(target->GetTargeted() >= kQueries, "clicks reach the widget under the cursor");
+
+	// Keeps the lookups observable
+	volatile size_t keep = sink;
+	(void)keep;
+
+	std::printf("%zu-widget window, %zu queries:\n", window.GetWidgetStore().GetCount(), kQueries);
+	std::printf("  grid hit test      : %8.3f us per query\n", 1000.0 * grid / kQueries);
+	std::printf("  tree walk          : %8.3f us per query\n", 1000.0 * walk / (kQueries / 20));
+	std::printf("  mouse move dispatch: %8.3f us per event\n", 1000.0 * moves / kQueries);
+	std::printf("  click dispatch     : %8.3f us per down/up pair\n", 1000.0 * clicks / (kQueries / 2));
+}
+
+int main()
+{
+	std::cout << "SnowUI Widget Arena Demo" << std::endl;
+
+	std::printf("%d-widget dialog:\n", kPanels * (kLabelsPerPanel + 1));
+	RunBenchmark("shared", BuildShared);
+	RunBenchmark("arena", BuildArena);
+	RunHitTestBenchmark();
+
+	// Show a smaller arena-built dialog
+	OpenGLBackend backend;
+	auto window = std::make_shared<Window>();
+	if (!window->Create("Widget Arena Demo", 800, 600, &backend))
+	{
+		std::cerr << "Failed to create window" << std::endl;
+		return 1;
+	}
+	for (int row = 0; row < 20; ++row)
+	{
+		Label* label = window->CreateWidget<Label>();
+		label->SetBounds(Rect(20.0f, 20.0f + static_cast<float>(row) * 25.0f, 300.0f, 20.0f));
+		label->SetText("Arena label " + std::to_string(row));
+		window->AddChild(label);
+	}
+
+	std::cout << "Running widget arena window (close window to exit)..." << std::endl;
+	window->Run();
+
+	std::cout << (g_failures == 0 ? "Demo completed successfully!" : "Demo completed with failures") << std::endl;
+
+	return g_failures == 0 ? 0 : 1;
+}
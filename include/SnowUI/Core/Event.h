@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 
 namespace SnowUI
@@ -11,22 +12,56 @@ namespace SnowUI
 		MouseMove,
 		MouseDown,
 		MouseUp,
+		MouseWheel,
 		KeyDown,
 		KeyUp,
 		Resize,
 		Paint,
 	};
 
+	// Routing of a dispatched event: Capture runs OnPreviewEvent from the root
+	// down to the target's parent, Target runs the target's OnEvent, and Bubble
+	// runs OnEvent from the target's parent back up to the root
+	enum class EventPhase : uint8_t
+	{
+		Capture,
+		Target,
+		Bubble,
+	};
+
+	// Microseconds on a monotonic clock, the unit of Event::timestamp
+	inline uint64_t GetEventTimestamp()
+	{
+		return static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+				.count());
+	}
+
 	struct Event
 	{
 		EventType type;
 		int x, y;
 		int button;
 		int keyCode;
+		int modifiers; // platform modifier bits (GLFW_MOD_*)
 		int width, height;
+		float wheelX, wheelY; // MouseWheel offsets, positive is away from the user
+		uint64_t timestamp;	  // when the input arrived, see GetEventTimestamp
+		EventPhase phase;
+		// Set by a handler to stop routing; handlers receive the event by const
+		// reference, so this is the one field they may change
+		mutable bool handled;
+
+		Event()
+			: type(EventType::None), x(0), y(0), button(0), keyCode(0), modifiers(0), width(0), height(0), wheelX(0.0f),
+			  wheelY(0.0f), timestamp(0), phase(EventPhase::Target), handled(false)
+		{
+		}
 
-		Event() : type(EventType::None), x(0), y(0), button(0), keyCode(0), width(0), height(0)
+		bool IsMouseEvent() const
 		{
+			return type == EventType::MouseMove || type == EventType::MouseDown || type == EventType::MouseUp ||
+			       type == EventType::MouseWheel;
 		}
 	};
 
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Event.h"
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace SnowUI
+{
+
+	// Counts of durations in power-of-two microsecond buckets: bucket i holds
+	// [2^i, 2^(i+1)) us and bucket 0 everything below 2 us. Cheap enough to record every
+	// event or frame, and enough to tell a 1 ms tail from a 16 ms one.
+	struct TimeHistogram
+	{
+		static constexpr int kBuckets = 24;
+
+		uint64_t counts[kBuckets] = {};
+		uint64_t total = 0;
+
+		void Add(uint64_t us)
+		{
+			int bucket = 0;
+			while (us > 1 && bucket < kBuckets - 1)
+			{
+				us >>= 1;
+				bucket++;
+			}
+			counts[bucket]++;
+			total++;
+		}
+
+		// Upper bound in us of the bucket holding the given fraction of samples
+		uint64_t GetPercentile(double fraction) const
+		{
+			const double target = fraction * static_cast<double>(total);
+			uint64_t seen = 0;
+			for (int i = 0; i < kBuckets; ++i)
+			{
+				seen += counts[i];
+				if (counts[i] && static_cast<double>(seen) >= target)
+					return uint64_t(2) << i;
+			}
+			return 0;
+		}
+	};
+
+	struct EventQueueStats
+	{
+		uint64_t pushed = 0;
+		uint64_t coalesced = 0; // pushes merged into an already queued event
+		uint64_t delivered = 0;
+		uint64_t totalLatencyUs = 0;
+		uint64_t maxLatencyUs = 0;
+		size_t lastBatchSize = 0;
+		TimeHistogram latency;
+
+		double GetMeanLatencyUs() const
+		{
+			return delivered ? static_cast<double>(totalLatencyUs) / delivered : 0.0;
+		}
+	};
+
+	// Input waiting to be dispatched. Platform callbacks push events as they
+	// arrive; the window drains the queue once per loop iteration and
+	// dispatches the batch.
+	//
+	// A MouseMove, Resize or MouseWheel pushed right after one of the same type
+	// is merged into it (latest position or size, summed wheel delta), so a
+	// 1000 Hz mouse costs one dispatch per frame rather than one per report.
+	// The merged event keeps the oldest timestamp, so measured latency covers
+	// the whole burst.
+	class EventQueue
+	{
+	  public:
+		// Stamps the event if it has no timestamp yet. Thread-safe.
+		void Push(const Event& event);
+
+		// Moves all queued events into batch, oldest first
+		void Drain(std::vector<Event>& batch);
+
+		bool IsEmpty() const;
+
+		// Records that an event was dispatched, for the latency statistics
+		void RecordDelivery(const Event& event, uint64_t now);
+
+		EventQueueStats GetStats() const;
+		void ResetStats();
+
+	  private:
+		mutable std::mutex mutex_;
+		std::vector<Event> events_;
+		EventQueueStats stats_;
+	};
+
+} // namespace SnowUI
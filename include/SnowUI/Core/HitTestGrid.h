@@ -0,0 +1,65 @@
+#pragma once
+
+#include "WidgetStore.h"
+#include <vector>
+
+namespace SnowUI
+{
+
+	// Cells a widget occupies in its window's HitTestGrid (inclusive range)
+	struct HitTestCells
+	{
+		int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+		bool indexed = false;
+		bool large = false; // kept in the large-widget list instead of cells
+	};
+
+	// Uniform grid over a window's surface mapping each cell to the slots of
+	// the widgets whose bounds overlap it, so a hit test only looks at the
+	// widgets near the point instead of walking the whole tree. Bounds,
+	// visibility and paint order are read from the window's WidgetStore.
+	//
+	// Widgets spanning many cells (containers, backgrounds) are kept in a
+	// separate list that every query checks, which keeps updates for them
+	// O(1) and the per-cell lists short. Bounds changes update only the cells
+	// the widget left or entered.
+	class HitTestGrid
+	{
+	  public:
+		static constexpr int kCellSize = 64;
+		static constexpr int kMaxCellsPerWidget = 64;
+
+		// Resizes the grid to cover width x height and indexes every widget
+		// in store except slot 0, the root, which is the fallback target
+		void Rebuild(const WidgetStore& store, int width, int height);
+
+		// Indexes the widgets in slots [first, last)
+		void Insert(const WidgetStore& store, WidgetSlot first, WidgetSlot last);
+		void Remove(WidgetSlot slot);
+		// Re-indexes a widget after its bounds changed
+		void Update(const WidgetStore& store, WidgetSlot slot);
+
+		// Topmost widget visible in the tree whose bounds contain (x, y), or
+		// kNoWidgetSlot. store must be refreshed.
+		WidgetSlot HitTest(const WidgetStore& store, float x, float y) const;
+
+		size_t GetWidgetCount() const
+		{
+			return widgetCount_;
+		}
+
+	  private:
+		HitTestCells GetCellRange(const Rect& bounds) const;
+		void AddToCells(WidgetSlot slot, const HitTestCells& range);
+		void RemoveFromCells(WidgetSlot slot, const HitTestCells& range);
+		static void EraseFrom(std::vector<WidgetSlot>& list, WidgetSlot slot);
+
+		int cellsX_ = 0;
+		int cellsY_ = 0;
+		std::vector<std::vector<WidgetSlot>> cells_;
+		std::vector<WidgetSlot> large_;
+		std::vector<HitTestCells> slotCells_; // by slot
+		size_t widgetCount_ = 0;
+	};
+
+} // namespace SnowUI
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace SnowUI
+{
+
+	// Tasks posted with the same non-zero key replace each other while queued
+	using PostKey = uint64_t;
+	constexpr PostKey kNoPostKey = 0;
+
+	struct PostQueueStats
+	{
+		uint64_t received = 0;
+		uint64_t coalesced = 0; // tasks replaced by a later post with their key
+		uint64_t run = 0;
+		size_t backlog = 0;		 // collected but left for the next iteration
+		size_t keySlotsInUse = 0; // keys holding a slot, i.e. with a post pending
+	};
+
+	// Tasks posted to the UI thread from any number of threads.
+	//
+	// Push() is lock-free: posting threads link their task onto a shared
+	// stack with one compare-exchange, and the UI thread takes the whole
+	// stack with one exchange. Only the push that finds the stack empty
+	// reports it, so a burst of posts wakes the loop once.
+	//
+	// A keyed task replaces the one still queued with the same key and runs
+	// in its place. A key with a post pending holds one of kKeySlots slots
+	// that posts swap their task into, so 10k updates of one value between
+	// two frames cost the UI thread a single task. The slot is released when
+	// the UI thread takes its task and nothing newer was posted, so the
+	// limit is on keys pending at once, not on keys ever used. Keys that find
+	// no free slot are coalesced when the UI thread collects them instead.
+	//
+	// Collected tasks wait in a backlog that Run() works through in posting
+	// order within a time budget, so a flood of posts cannot stall input and
+	// drawing.
+	class PostQueue
+	{
+	  public:
+		static constexpr size_t kKeySlots = 1024;
+
+		PostQueue();
+		~PostQueue();
+
+		PostQueue(const PostQueue&) = delete;
+		PostQueue& operator=(const PostQueue&) = delete;
+
+		// Thread-safe. Returns true if the queue was empty, i.e. the consumer
+		// may be asleep and needs waking.
+		bool Push(PostKey key, std::function<void()> task);
+
+		// UI thread: runs tasks posted so far, oldest first, until budget is
+		// spent; at least one runs. Tasks they post run on a later call.
+		// Returns true if some are left over.
+		bool Run(std::chrono::microseconds budget);
+
+		bool HasBacklog() const
+		{
+			return !backlog_.empty();
+		}
+
+		PostQueueStats GetStats() const;
+
+	  private:
+		using Task = std::function<void()>;
+
+		// Latest task of one key; queued while pending is set
+		struct KeySlot
+		{
+			std::atomic<PostKey> key{kNoPostKey};
+			std::atomic<Task*> pending{nullptr};
+			// Pushes between FindSlot() and their swap, plus kReleasing while
+			// the UI thread frees the slot
+			std::atomic<uint32_t> users{0};
+			std::atomic<uint64_t> replaced{0};
+		};
+		static constexpr uint32_t kReleasing = 1u << 31;
+
+		struct Node
+		{
+			PostKey key;
+			Task task;	   // empty for a slot's node
+			KeySlot* slot; // nullptr unless the key has a slot
+			Node* next;
+		};
+
+		struct Entry
+		{
+			PostKey key;
+			Task task; // the slot's pending task runs instead if there is one
+			KeySlot* slot;
+		};
+
+		// Slot of key, claiming a free one for a new key; nullptr if full.
+		// The caller holds the slot as a user until it has swapped its task in.
+		KeySlot* FindSlot(PostKey key);
+		// UI thread: frees a slot whose task was taken, unless a push holds it
+		// or has already queued a newer task
+		void ReleaseSlot(KeySlot& slot);
+		// Returns true if the stack was empty
+		bool PushNode(Node* node);
+		// Moves everything pushed so far to the back of backlog_
+		void Collect();
+
+		std::atomic<Node*> head_; // newest first
+		std::unique_ptr<KeySlot[]> slots_;
+
+		// UI thread only
+		std::deque<Entry> backlog_;
+		uint64_t backlogBase_ = 0; // sequence number of backlog_.front()
+		// Entry of each queued key that has no slot
+		std::unordered_map<PostKey, uint64_t> latest_;
+		std::vector<Node*> collected_;
+		PostQueueStats stats_;
+	};
+
+} // namespace SnowUI
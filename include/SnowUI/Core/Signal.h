@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SnowUI
+{
+
+	template <typename Signature> class Delegate;
+
+	// Callable stored in place: a function pointer, a member function bound
+	// to an object, or a lambda whose captures fit in kInlineSize bytes.
+	// Unlike std::function it never allocates; a larger callable is a
+	// compile error, and the fix is to capture a pointer to its state.
+	// Copying one with trivially copyable captures is a plain memcpy.
+	template <typename R, typename... Args> class Delegate<R(Args...)>
+	{
+	  public:
+		static constexpr size_t kInlineSize = 4 * sizeof(void*);
+
+		Delegate() noexcept : invoke_(nullptr), manage_(nullptr)
+		{
+		}
+		Delegate(std::nullptr_t) noexcept : Delegate()
+		{
+		}
+
+		template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Delegate>::value &&
+		                                                  std::is_invocable_r<R, std::decay_t<F>&, Args...>::value>>
+		Delegate(F&& callable) : Delegate()
+		{
+			Store(std::forward<F>(callable));
+		}
+
+		template <typename T>
+		Delegate(T* object, R (T::*method)(Args...))
+			: Delegate([object, method](Args... args) -> R { return (object->*method)(std::forward<Args>(args)...); })
+		{
+		}
+		template <typename T>
+		Delegate(const T* object, R (T::*method)(Args...) const)
+			: Delegate([object, method](Args... args) -> R { return (object->*method)(std::forward<Args>(args)...); })
+		{
+		}
+
+		Delegate(const Delegate& other) : Delegate()
+		{
+			CopyFrom(other);
+		}
+		Delegate(Delegate&& other) noexcept : Delegate()
+		{
+			MoveFrom(other);
+		}
+		Delegate& operator=(const Delegate& other)
+		{
+			if (this != &other)
+			{
+				Reset();
+				CopyFrom(other);
+			}
+			return *this;
+		}
+		Delegate& operator=(Delegate&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Reset();
+				MoveFrom(other);
+			}
+			return *this;
+		}
+		~Delegate()
+		{
+			Reset();
+		}
+
+		void Reset() noexcept
+		{
+			if (manage_)
+				manage_(Operation::Destroy, storage_, nullptr);
+			invoke_ = nullptr;
+			manage_ = nullptr;
+		}
+
+		explicit operator bool() const noexcept
+		{
+			return invoke_ != nullptr;
+		}
+
+		// Must not be empty
+		R operator()(Args... args) const
+		{
+			return invoke_(const_cast<unsigned char*>(storage_), std::forward<Args>(args)...);
+		}
+
+	  private:
+		enum class Operation
+		{
+			Copy,
+			Move,
+			Destroy,
+		};
+
+		template <typename F> void Store(F&& callable)
+		{
+			using Callable = std::decay_t<F>;
+			static_assert(sizeof(Callable) <= kInlineSize,
+			              "Delegate: callable too large to store in place; capture a pointer to its state instead");
+			static_assert(alignof(Callable) <= alignof(std::max_align_t), "Delegate: callable is over-aligned");
+			static_assert(std::is_nothrow_move_constructible<Callable>::value,
+			              "Delegate: callable must be nothrow move constructible");
+
+			new (storage_) Callable(std::forward<F>(callable));
+			invoke_ = [](void* storage, Args... args) -> R {
+				return (*static_cast<Callable*>(storage))(std::forward<Args>(args)...);
+			};
+			manage_ = std::is_trivially_copyable<Callable>::value ? nullptr : &Manage<Callable>;
+		}
+
+		template <typename Callable> static void Manage(Operation operation, void* target, void* source)
+		{
+			switch (operation)
+			{
+			case Operation::Copy:
+				new (target) Callable(*static_cast<const Callable*>(source));
+				break;
+			case Operation::Move:
+				new (target) Callable(std::move(*static_cast<Callable*>(source)));
+				break;
+			case Operation::Destroy:
+				static_cast<Callable*>(target)->~Callable();
+				break;
+			}
+		}
+
+		void CopyFrom(const Delegate& other)
+		{
+			if (other.manage_)
+				other.manage_(Operation::Copy, storage_, const_cast<unsigned char*>(other.storage_));
+			else
+				std::memcpy(storage_, other.storage_, kInlineSize);
+			invoke_ = other.invoke_;
+			manage_ = other.manage_;
+		}
+
+		void MoveFrom(Delegate& other) noexcept
+		{
+			if (other.manage_)
+				other.manage_(Operation::Move, storage_, other.storage_);
+			else
+				std::memcpy(storage_, other.storage_, kInlineSize);
+			invoke_ = other.invoke_;
+			manage_ = other.manage_;
+			other.Reset();
+		}
+
+		alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+		R (*invoke_)(void*, Args...);
+		void (*manage_)(Operation, void*, void*); // nullptr for trivially copyable callables
+	};
+
+	// Identifies a connection within its signal; never 0
+	using ConnectionId = uint32_t;
+
+	class Trackable;
+
+	class SignalBase
+	{
+	  protected:
+		friend class Trackable;
+
+		~SignalBase() = default;
+
+		// The receiver of connection id is going away
+		virtual void ForgetReceiver(ConnectionId id) = 0;
+	};
+
+	// Base of objects whose signal connections must end with them. Widget
+	// derives from it, so a slot connected on a widget's behalf is
+	// disconnected when the widget is destroyed, whichever side goes first.
+	class Trackable
+	{
+	  public:
+		Trackable() = default;
+		// Connections belong to the original object, not to copies
+		Trackable(const Trackable&)
+		{
+		}
+		Trackable& operator=(const Trackable&)
+		{
+			return *this;
+		}
+		~Trackable()
+		{
+			for (const Link& link : connections_)
+			{
+				link.signal->ForgetReceiver(link.id);
+			}
+		}
+
+	  private:
+		template <typename... Args> friend class Signal;
+
+		struct Link
+		{
+			SignalBase* signal;
+			ConnectionId id;
+		};
+
+		void Track(SignalBase* signal, ConnectionId id)
+		{
+			connections_.push_back(Link{signal, id});
+		}
+		void Forget(SignalBase* signal, ConnectionId id)
+		{
+			auto it = std::find_if(connections_.begin(), connections_.end(),
+			                       [&](const Link& link) { return link.signal == signal && link.id == id; });
+			if (it != connections_.end())
+			{
+				*it = connections_.back();
+				connections_.pop_back();
+			}
+		}
+
+		std::vector<Link> connections_;
+	};
+
+	// Multicast notification: Emit() calls every connected slot in the order
+	// they were connected. UI thread only.
+	//
+	// Slots are Delegates kept in one array, so connecting never allocates
+	// beyond the array's growth and emitting is one indirect call per slot
+	// with nothing to lock or count. A signal nobody listens to costs a size
+	// check. Slots may connect and disconnect, themselves included, during
+	// an emission: new ones are called from the next emission on, removed
+	// ones are skipped. The signal itself must outlive its emission.
+	template <typename... Args> class Signal : private SignalBase
+	{
+	  public:
+		using Slot = Delegate<void(Args...)>;
+
+		Signal() : nextId_(1), emitting_(0), dirty_(false)
+		{
+		}
+		Signal(const Signal&) = delete;
+		Signal& operator=(const Signal&) = delete;
+		~Signal()
+		{
+			for (std::vector<Connection>* list : {&connections_, &pending_})
+			{
+				for (const Connection& connection : *list)
+				{
+					if (connection.connected && connection.receiver)
+						connection.receiver->Forget(this, connection.id);
+				}
+			}
+		}
+
+		ConnectionId Connect(Slot slot)
+		{
+			return Add(nullptr, std::move(slot));
+		}
+		// Connects a slot that ends when receiver is destroyed
+		ConnectionId Connect(Trackable* receiver, Slot slot)
+		{
+			return Add(receiver, std::move(slot));
+		}
+		// Connects object->method, ending with object if it is Trackable
+		template <typename T> ConnectionId Connect(T* object, void (T::*method)(Args...))
+		{
+			Trackable* receiver = nullptr;
+			if constexpr (std::is_base_of<Trackable, T>::value)
+				receiver = object;
+			return Add(receiver, Slot(object, method));
+		}
+
+		void Disconnect(ConnectionId id)
+		{
+			if (Connection* connection = Find(id))
+			{
+				if (connection->receiver)
+					connection->receiver->Forget(this, id);
+				Remove(*connection);
+			}
+		}
+		void DisconnectAll()
+		{
+			for (std::vector<Connection>* list : {&connections_, &pending_})
+			{
+				for (Connection& connection : *list)
+				{
+					if (connection.connected && connection.receiver)
+						connection.receiver->Forget(this, connection.id);
+					connection.connected = false;
+					connection.receiver = nullptr;
+				}
+			}
+			if (emitting_)
+				dirty_ = true;
+			else
+				Compact();
+		}
+
+		bool IsEmpty() const
+		{
+			return connections_.empty() && pending_.empty();
+		}
+
+		void Emit(Args... args)
+		{
+			if (connections_.empty())
+				return;
+
+			emitting_++;
+			for (size_t i = 0; i < connections_.size(); ++i)
+			{
+				const Connection& connection = connections_[i];
+				if (connection.connected)
+					connection.slot(args...);
+			}
+			if (--emitting_ == 0 && dirty_)
+				Compact();
+		}
+		void operator()(Args... args)
+		{
+			Emit(std::forward<Args>(args)...);
+		}
+
+	  private:
+		struct Connection
+		{
+			ConnectionId id;
+			bool connected;
+			Trackable* receiver;
+			Slot slot;
+		};
+
+		ConnectionId Add(Trackable* receiver, Slot slot)
+		{
+			const ConnectionId id = nextId_++;
+			// Growing connections_ mid-emission would move the running slot
+			std::vector<Connection>& target = emitting_ ? pending_ : connections_;
+			target.push_back(Connection{id, true, receiver, std::move(slot)});
+			if (emitting_)
+				dirty_ = true;
+			if (receiver)
+				receiver->Track(this, id);
+			return id;
+		}
+
+		// Ids grow with each connection, so both arrays are sorted by id
+		Connection* Find(ConnectionId id)
+		{
+			for (std::vector<Connection>* list : {&connections_, &pending_})
+			{
+				auto it = std::lower_bound(list->begin(), list->end(), id,
+				                           [](const Connection& connection, ConnectionId key) { return connection.id < key; });
+				if (it != list->end() && it->id == id && it->connected)
+					return &*it;
+			}
+			return nullptr;
+		}
+
+		void Remove(Connection& connection)
+		{
+			// A slot may disconnect itself while it runs; it is freed once the
+			// emission is over
+			connection.connected = false;
+			connection.receiver = nullptr;
+			if (emitting_)
+				dirty_ = true;
+			else
+				Compact();
+		}
+
+		void Compact()
+		{
+			connections_.erase(std::remove_if(connections_.begin(), connections_.end(),
+			                                  [](const Connection& connection) { return !connection.connected; }),
+			                   connections_.end());
+			for (Connection& connection : pending_)
+			{
+				if (connection.connected)
+					connections_.push_back(std::move(connection));
+			}
+			pending_.clear();
+			dirty_ = false;
+		}
+
+		void ForgetReceiver(ConnectionId id) override
+		{
+			if (Connection* connection = Find(id))
+				Remove(*connection);
+		}
+
+		std::vector<Connection> connections_;
+		std::vector<Connection> pending_; // connected during an emission
+		ConnectionId nextId_;
+		int emitting_;
+		bool dirty_;
+	};
+
+} // namespace SnowUI
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SnowUI
+{
+
+	// Tasks spawned together and waited for together (see ThreadPool::Spawn)
+	class TaskGroup
+	{
+	  public:
+		TaskGroup() : pending_(0)
+		{
+		}
+
+		bool IsDone() const
+		{
+			return pending_.load(std::memory_order_acquire) == 0;
+		}
+
+	  private:
+		friend class ThreadPool;
+
+		std::atomic<size_t> pending_;
+	};
+
+	// Fixed-size pool of worker threads used for data-parallel work.
+	//
+	// ParallelFor hands out indices from a shared counter; the calling thread
+	// takes part in the loop, so a pool of N threads runs N + 1 ways wide and
+	// a pool of zero threads degenerates to a plain serial loop.
+	//
+	// Spawn/Wait run fork-join work such as tree walks. Each worker keeps its
+	// own deque: it pushes and pops its spawned tasks at the back, depth
+	// first, and idle threads steal from the front of the others, which
+	// takes the oldest and usually largest pieces of work. Wait() runs tasks
+	// until its group is done, so tasks may spawn and wait in turn.
+	class ThreadPool
+	{
+	  public:
+		// workerCount < 0 picks hardware_concurrency() - 1 workers
+		explicit ThreadPool(int workerCount = -1);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// Number of threads that participate in ParallelFor, including the caller
+		int GetConcurrency() const
+		{
+			return static_cast<int>(workers_.size()) + 1;
+		}
+
+		// Runs fn(i) for every i in [0, count) and returns when all calls finished.
+		// Not reentrant: fn must not call ParallelFor on the same pool.
+		void ParallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+		// Queues task as part of group. Without workers it runs right away.
+		void Spawn(TaskGroup& group, std::function<void()> task);
+		// Runs queued tasks, this group's or others', until group is done
+		void Wait(TaskGroup& group);
+
+	  private:
+		struct Task
+		{
+			std::function<void()> fn;
+			TaskGroup* group;
+		};
+
+		// A worker's deque; the last one is shared by threads outside the pool
+		struct TaskQueue
+		{
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		void WorkerLoop(size_t index);
+		void RunJob();
+		// Pops from queue index or steals from another one; false if all are empty
+		bool RunOneTask(size_t index);
+		size_t GetQueueIndex() const;
+
+		std::vector<std::thread> workers_;
+		std::vector<std::unique_ptr<TaskQueue>> queues_;
+		std::atomic<size_t> queuedTasks_;
+
+		std::mutex mutex_;
+		std::condition_variable wake_;
+		std::condition_variable done_;
+		bool stopping_;
+		uint64_t generation_;
+		int activeWorkers_;
+
+		const std::function<void(size_t)>* job_;
+		size_t jobCount_;
+		std::atomic<size_t> nextIndex_;
+	};
+
+} // namespace SnowUI
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SnowUI
+{
+
+	// Case-insensitive substring index over a growing list of strings.
+	//
+	// Every string is split into its overlapping one-, two- and three-byte
+	// sequences, and each maps to the ids of the strings containing it. A query
+	// of up to three bytes is answered by a single posting list; a longer one
+	// intersects the lists of its trigrams and checks the few survivors. Ids
+	// are assigned densely in insertion order, so posting lists stay sorted
+	// without any re-sorting on Add().
+	//
+	// Matching folds ASCII letters only; other bytes compare exactly.
+	class TrigramIndex
+	{
+	  public:
+		// Indexes text under the next id (0, 1, 2, ...) and returns it
+		uint32_t Add(std::string_view text);
+		void Clear();
+		void Reserve(size_t count, size_t textBytes);
+
+		size_t GetCount() const
+		{
+			return offsets_.size();
+		}
+
+		// Ids of all strings containing query, ascending
+		void Search(std::string_view query, std::vector<uint32_t>& results) const;
+
+		// Ids from candidates (ascending) that contain query. When the user
+		// extends a query, refining the previous results is cheaper than a
+		// new search.
+		void Refine(std::string_view query, const std::vector<uint32_t>& candidates,
+		            std::vector<uint32_t>& results) const;
+
+		// True if text contains query under this index's case folding
+		static bool Matches(std::string_view text, std::string_view query);
+
+		// Lower-cases ASCII letters, as done for indexed text and queries
+		static void Fold(std::string_view text, std::string& out);
+
+	  private:
+		// Posting lists of folded's grams (its trigrams, or the whole query if
+		// shorter) into lists_, shortest first; returns the shortest, or
+		// nullptr if some gram never occurs
+		const std::vector<uint32_t>* GatherPostings(std::string_view folded) const;
+
+		// Up to three bytes plus the length, so "a" and "a\0\0" differ
+		static uint32_t MakeGram(const char* p, size_t length)
+		{
+			uint32_t gram = static_cast<uint32_t>(length) << 24;
+			for (size_t i = 0; i < length; ++i)
+			{
+				gram |= static_cast<uint32_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+			}
+			return gram;
+		}
+
+		std::string_view GetFolded(uint32_t id) const
+		{
+			const uint32_t begin = offsets_[id];
+			const uint32_t end = id + 1 < offsets_.size() ? offsets_[id + 1] : static_cast<uint32_t>(folded_.size());
+			return std::string_view(folded_.data() + begin, end - begin);
+		}
+
+		std::string folded_;			// all strings, folded, back to back
+		std::vector<uint32_t> offsets_; // start of each string in folded_
+		std::unordered_map<uint32_t, std::vector<uint32_t>> postings_;
+		std::vector<uint32_t> scratch_; // grams of the string being added
+		mutable std::string query_;
+		mutable std::vector<const std::vector<uint32_t>*> lists_;
+	};
+
+} // namespace SnowUI
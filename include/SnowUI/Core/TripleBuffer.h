@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace SnowUI
+{
+
+	// Lock-free handoff of the latest value from one producer thread to one
+	// consumer thread.
+	//
+	// There are three slots: the producer fills its back slot, the consumer
+	// reads its front slot, and the third holds the newest published value.
+	// Publish() and Acquire() swap a private slot with the shared one in a
+	// single atomic exchange, so neither side ever waits for the other. A
+	// value published before the consumer took the previous one replaces it:
+	// the consumer always gets the newest, never a queue of stale ones.
+	template <typename T> class TripleBuffer
+	{
+	  public:
+		TripleBuffer() : shared_(2), back_(0), front_(1)
+		{
+		}
+
+		TripleBuffer(const TripleBuffer&) = delete;
+		TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+		// Producer side: the slot to fill before Publish()
+		T& GetWriteBuffer()
+		{
+			return slots_[back_];
+		}
+
+		// Makes the write buffer the newest value. Returns false if that
+		// replaced a value the consumer never acquired.
+		bool Publish()
+		{
+			const uint8_t previous = shared_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel);
+			back_ = previous & kIndexMask;
+			return (previous & kFresh) == 0;
+		}
+
+		// Consumer side: true if a value was published since the last Acquire()
+		bool HasFresh() const
+		{
+			return (shared_.load(std::memory_order_acquire) & kFresh) != 0;
+		}
+
+		// Takes the newest value into the read buffer; false if there is none
+		bool Acquire()
+		{
+			if (!HasFresh())
+				return false;
+			const uint8_t previous = shared_.exchange(front_, std::memory_order_acq_rel);
+			front_ = previous & kIndexMask;
+			return true;
+		}
+
+		T& GetReadBuffer()
+		{
+			return slots_[front_];
+		}
+
+	  private:
+		static constexpr uint8_t kIndexMask = 3;
+		static constexpr uint8_t kFresh = 4;
+
+		T slots_[3];
+		std::atomic<uint8_t> shared_; // index of the shared slot, | kFresh if unread
+		alignas(64) uint8_t back_;	  // producer only
+		alignas(64) uint8_t front_;	  // consumer only
+	};
+
+} // namespace SnowUI
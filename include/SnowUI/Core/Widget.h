@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Event.h"
+#include "Signal.h"
+#include "WidgetStore.h"
 #include "../Render/DrawCommand.h"
 #include <vector>
 #include <memory>
@@ -9,30 +11,96 @@
 namespace SnowUI
 {
 
-	class Widget
+	class Layout;
+	class ThreadPool;
+
+	// Widgets record their own drawing into a cached fragment that is only
+	// re-recorded after Invalidate(). Each widget also keeps a DrawChain
+	// linking its fragment and its visible children's chains in paint order,
+	// so the tree is drawn straight from the per-widget recordings. Only the
+	// chains on the path to a re-recorded widget are relinked; commands are
+	// never copied between widgets, and a clean subtree costs one link.
+	//
+	// OnPaint() records the widget's own content only; children are drawn
+	// after it. Subclasses call Invalidate() whenever state that
+	// affects OnPaint() changes. The area a widget covered before and after
+	// the change is reported to the root as damage (see OnDamage).
+	//
+	// Signal connections made on a widget's behalf (Signal::Connect with the
+	// widget as receiver) end when it is destroyed.
+	class Widget : public Trackable
 	{
 	  public:
 		Widget();
 		virtual ~Widget() = default;
 
+		// Appends this widget and its children, re-recording only dirty parts.
+		// Copies every command; windows draw from the chain instead.
+		void Paint(DrawList& drawList);
+
 		virtual void OnPaint(DrawList& drawList);
+		// True if OnPaint() may run on another thread while other subtrees
+		// paint, i.e. it reads only this widget and thread-safe shared state
+		// such as MeasureText(). Subclasses opt in; the default OnPaint()
+		// is safe, so a plain Widget answers true and anything derived false.
+		virtual bool IsPaintThreadSafe() const;
+		// Called for the target of an event and, while bubbling, for each of
+		// its ancestors (see EventPhase)
 		virtual void OnEvent(const Event& event);
+		// Called on ancestors of the target before it sees the event
+		virtual void OnPreviewEvent(const Event& event);
 		virtual void SetBounds(const Rect& bounds);
+		// Size the widget wants from a Layout, from its content alone. The
+		// default wants nothing and takes whatever the layout hands out.
+		virtual Size OnMeasure();
+
+		// Marks the widget for repainting and flags every ancestor so the next
+		// Paint() reaches it
+		void Invalidate();
+
+		// Tells the Layout holding this widget, if any, that OnMeasure() may
+		// return something else now
+		void InvalidateMeasure();
+
+		// True if the widget or any descendant needs repainting
+		bool IsPaintPending() const
+		{
+			return paintDirty_ || childDirty_;
+		}
+
+		Widget* GetParent() const
+		{
+			return parent_;
+		}
+		Widget* GetRoot();
+
+		// Slot in the window's WidgetStore, or kNoWidgetSlot outside a window
+		WidgetSlot GetStoreSlot() const
+		{
+			return storeSlot_;
+		}
+
+		// True if this widget and all of its ancestors are visible
+		bool IsVisibleInTree() const;
+
+		// True if this widget is drawn on top of other, i.e. later in paint order
+		bool IsPaintedAfter(const Widget& other) const;
 
 		const Rect& GetBounds() const
 		{
 			return bounds_;
 		}
+		// Attaches a child and shares ownership of it
 		void AddChild(std::shared_ptr<Widget> child);
-		const std::vector<std::shared_ptr<Widget>>& GetChildren() const
+		// Attaches a child owned elsewhere, e.g. by a WidgetArena; it must
+		// outlive this widget's use of it
+		void AddChild(Widget* child);
+		const std::vector<Widget*>& GetChildren() const
 		{
 			return children_;
 		}
 
-		void SetVisible(bool visible)
-		{
-			visible_ = visible;
-		}
+		void SetVisible(bool visible);
 		bool IsVisible() const
 		{
 			return visible_;
@@ -40,7 +108,11 @@ namespace SnowUI
 
 		void SetText(const std::string& text)
 		{
+			if (text_ == text)
+				return;
 			text_ = text;
+			InvalidateMeasure();
+			Invalidate();
 		}
 		const std::string& GetText() const
 		{
@@ -48,10 +120,75 @@ namespace SnowUI
 		}
 
 	  protected:
+		// Flags the parent's subtree so a change in this widget's visibility
+		// or placement is picked up without re-recording this widget
+		void InvalidateParent();
+
+		// Like Invalidate(), but reports only rect as damage. For changes that
+		// stay inside part of the widget, e.g. one row of a list; the next
+		// OnPaint() must draw everything outside rect exactly as before.
+		void InvalidateArea(const Rect& rect);
+
+		// Reports a screen area whose pixels change to the root widget
+		void AddDamage(const Rect& rect);
+
+		// For the root: re-records whatever is pending and returns the chain of
+		// the whole tree. With a pool, pending children whose subtrees are all
+		// IsPaintThreadSafe() re-record on it; their damage is reported
+		// afterwards in paint order, as a serial recording would.
+		const DrawChain& RecordChain(ThreadPool* pool);
+
+		// Called on the root of the tree for every damaged area
+		virtual void OnDamage(const Rect& rect)
+		{
+			(void)rect;
+		}
+
+		// Called on the root when a subtree is attached below it, and when a
+		// widget below it changes bounds
+		virtual void OnDescendantAttached(Widget& child)
+		{
+			(void)child;
+		}
+		virtual void OnDescendantMoved(Widget& widget)
+		{
+			(void)widget;
+		}
+		// Called on the root when it or a widget below it is shown or hidden
+		virtual void OnVisibilityChanged(Widget& widget)
+		{
+			(void)widget;
+		}
+
 		Rect bounds_;
-		std::vector<std::shared_ptr<Widget>> children_;
+		std::vector<Widget*> children_;					   // in paint order
+		std::vector<std::shared_ptr<Widget>> ownedChildren_; // those added by shared_ptr
+		Widget* parent_;
 		bool visible_;
 		std::string text_;
+
+	  private:
+		friend class WidgetStore;
+		friend class Layout;
+
+		// Re-records what is pending in this subtree and relinks chain_; pool
+		// as for RecordChain()
+		void Record(ThreadPool* pool);
+		// Records OnPaint() into fragment_ and reports the damage it causes
+		void RecordContent();
+		void RecordChildren(ThreadPool* pool);
+
+		DrawList fragment_; // this widget's own commands, as last recorded
+		DrawChain chain_;	// fragment_, then each visible child's chain_
+		Rect paintedRect_;	// extent of the widget's own recorded commands
+		Rect subtreeRect_;	// extent of the whole subtree
+		bool paintDirty_;	// own content must be re-recorded
+		bool partialPaint_; // paintDirty_ came from InvalidateArea() only
+		bool childDirty_;	// some descendant must be re-recorded
+		bool paintThreadSafeTree_; // every descendant IsPaintThreadSafe()
+		size_t siblingIndex_; // position in the parent's children
+		WidgetSlot storeSlot_;
+		Layout* ownerLayout_; // the Layout this widget was added to
 	};
 
 } // namespace SnowUI
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace SnowUI
+{
+
+	class Widget;
+
+	// Owns widgets allocated back to back in large blocks.
+	//
+	// Widgets created here are attached with Widget::AddChild(Widget*) and
+	// referenced by plain pointers, which stay valid until the arena is
+	// cleared: no per-widget heap allocation, no reference counting, and a
+	// tree built in paint order is laid out in memory in that order.
+	// Teardown runs the destructors newest first and frees a handful of
+	// blocks. Widgets cannot be freed individually.
+	class WidgetArena
+	{
+	  public:
+		static constexpr size_t kBlockSize = 64 * 1024;
+
+		WidgetArena() = default;
+		~WidgetArena()
+		{
+			Clear();
+		}
+
+		WidgetArena(const WidgetArena&) = delete;
+		WidgetArena& operator=(const WidgetArena&) = delete;
+
+		template <typename T, typename... Args> T* Create(Args&&... args)
+		{
+			static_assert(std::is_base_of<Widget, T>::value, "WidgetArena only holds widgets");
+			void* memory = Allocate(sizeof(T), alignof(T));
+			T* widget = new (memory) T(std::forward<Args>(args)...);
+			widgets_.push_back(widget);
+			return widget;
+		}
+
+		// Destroys every widget, newest first, and releases the memory
+		void Clear();
+
+		size_t GetWidgetCount() const
+		{
+			return widgets_.size();
+		}
+		size_t GetBytesReserved() const
+		{
+			return bytesReserved_;
+		}
+
+	  private:
+		void* Allocate(size_t size, size_t alignment);
+
+		std::vector<std::unique_ptr<unsigned char[]>> blocks_;
+		unsigned char* cursor_ = nullptr;
+		size_t remaining_ = 0;
+		size_t bytesReserved_ = 0;
+		std::vector<Widget*> widgets_;
+	};
+
+} // namespace SnowUI
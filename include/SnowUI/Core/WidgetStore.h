@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../Render/DrawCommand.h"
+#include <cstdint>
+#include <vector>
+
+namespace SnowUI
+{
+
+	class Widget;
+
+	// Index of a widget in its window's WidgetStore
+	using WidgetSlot = uint32_t;
+	static constexpr WidgetSlot kNoWidgetSlot = ~0u;
+
+	// Per-widget fields that window-wide passes read, kept as one dense array
+	// per field and indexed by slot: bounds, visibility, parent and paint
+	// order. Widgets keep their own bounds_ and visible_ for behavior code;
+	// the window mirrors every change here through the root hooks, so a pass
+	// over many widgets walks a few arrays instead of chasing pointers
+	// through widget objects.
+	//
+	// Paint order and visibility-in-tree are derived lazily. A structural
+	// change renumbers the tree once, parents before children, after which
+	// visibility is a single linear pass in that order.
+	class WidgetStore
+	{
+	  public:
+		// Gives widget and its descendants the next free slots, depth first;
+		// widgets that already have a slot are skipped. Returns the first new
+		// slot, so the new widgets are [first, GetCount()).
+		WidgetSlot AddTree(Widget& widget);
+		void Clear();
+
+		void SetBounds(WidgetSlot slot, const Rect& bounds)
+		{
+			bounds_[slot] = bounds;
+		}
+		void SetVisible(WidgetSlot slot, bool visible);
+
+		size_t GetCount() const
+		{
+			return widgets_.size();
+		}
+		Widget* GetWidget(WidgetSlot slot) const
+		{
+			return widgets_[slot];
+		}
+		WidgetSlot GetParent(WidgetSlot slot) const
+		{
+			return parents_[slot];
+		}
+		const Rect& GetBounds(WidgetSlot slot) const
+		{
+			return bounds_[slot];
+		}
+
+		// Recomputes paint order and visibility-in-tree if anything changed.
+		// The two queries below need it to have been called since.
+		void Refresh();
+
+		// True if the widget and all of its ancestors are visible
+		bool IsVisibleInTree(WidgetSlot slot) const
+		{
+			return visibleInTree_[slot] != 0;
+		}
+		// True if a is drawn on top of b
+		bool IsPaintedAfter(WidgetSlot a, WidgetSlot b) const
+		{
+			return paintOrder_[a] > paintOrder_[b];
+		}
+
+	  private:
+		void RenumberPaintOrder();
+
+		std::vector<Rect> bounds_;
+		std::vector<uint8_t> visible_;
+		std::vector<uint8_t> visibleInTree_;
+		std::vector<WidgetSlot> parents_;
+		std::vector<uint32_t> paintOrder_;	  // position in paintSlots_
+		std::vector<WidgetSlot> paintSlots_; // slots, parents before children
+		std::vector<Widget*> widgets_;
+		std::vector<Widget*> stack_;
+		bool orderDirty_ = false;
+		bool visibilityDirty_ = false;
+	};
+
+} // namespace SnowUI
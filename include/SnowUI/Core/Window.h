@@ -1,18 +1,53 @@
 #pragma once
 
 #include "Widget.h"
+#include "HitTestGrid.h"
+#include "EventQueue.h"
+#include "PostQueue.h"
+#include "WidgetArena.h"
+#include "TripleBuffer.h"
+#include "../Layout/Layout.h"
 #include "../Render/IRenderBackend.h"
-#include <memory>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace SnowUI
 {
 
+	struct FrameStats
+	{
+		uint64_t pixelsRedrawn = 0;
+		uint32_t damageRectCount = 0;
+		uint64_t renderTimeUs = 0; // how long Render() held the UI thread
+	};
+
+	struct RenderThreadStats
+	{
+		uint64_t published = 0; // frames handed to the render thread
+		uint64_t dropped = 0;	// replaced by a newer one before it was drawn
+		uint64_t presented = 0;
+	};
+
+	using TimerId = uint32_t;
+
+	// Top-level widget. Window collects the damage reported by its widgets
+	// and asks the backend to redraw only those areas.
+	//
+	// Run() is event driven: it renders only when something is invalidated,
+	// a frame was requested or the backend needs one, and otherwise blocks
+	// in the backend until input arrives, a timer is due or a task is posted.
 	class Window : public Widget
 	{
 	  public:
 		Window();
-		virtual ~Window() = default;
+		virtual ~Window();
 
 		bool Create(const std::string& title, int width, int height, IRenderBackend* backend);
 		void Show();
@@ -23,6 +58,117 @@ namespace SnowUI
 		// Main event loop - runs until window is closed
 		void Run();
 
+		// Routes an event to its target: for mouse events the topmost widget
+		// under the cursor (or the widget holding the mouse since MouseDown),
+		// for key events the widget last clicked. Returns true if a handler
+		// marked the event handled.
+		bool DispatchEvent(const Event& event);
+
+		// Queues input for the next loop iteration, as the platform callbacks
+		// do. Thread-safe.
+		void QueueEvent(const Event& event);
+
+		// Input waiting for dispatch and its latency statistics
+		EventQueue& GetEventQueue()
+		{
+			return eventQueue_;
+		}
+
+		// Creates a widget in this window's arena, to be attached with
+		// AddChild(Widget*) anywhere in the window. It lives as long as the
+		// window; large dialogs built this way skip a heap allocation and a
+		// reference count per widget.
+		template <typename T, typename... Args> T* CreateWidget(Args&&... args)
+		{
+			return arena_.Create<T>(std::forward<Args>(args)...);
+		}
+		WidgetArena& GetWidgetArena()
+		{
+			return arena_;
+		}
+
+		// Layout that places the window's widgets over its whole area. It is
+		// re-run before each frame and after resizes, and only does work for
+		// what changed since.
+		void SetLayout(std::shared_ptr<Layout> layout);
+		Layout* GetLayout() const
+		{
+			return layout_.get();
+		}
+		// Lays out independent subtrees on pool's threads; nullptr (the
+		// default) lays out on the UI thread only. The pool must outlive its
+		// use here and may be shared between windows.
+		void SetLayoutPool(ThreadPool* pool)
+		{
+			layoutPool_ = pool;
+		}
+
+		// Records the window's top-level subtrees in parallel on pool, for
+		// those whose widgets are all IsPaintThreadSafe(). nullptr (the
+		// default) records serially. Either way the backend is handed the
+		// widgets' recordings chained in z-order.
+		void SetPaintPool(ThreadPool* pool);
+
+		// Moves drawing and the backend's blocking swap to a dedicated render
+		// thread that owns the backend's context. Render() then only lays out,
+		// records and publishes the frame through a lock-free triple buffer;
+		// the render thread always draws the newest frame and skips any it
+		// fell behind on, so a slow swap no longer delays input handling.
+		// Call after Create(); false stops the thread and draws on the UI
+		// thread again.
+		void SetRenderThread(bool enabled);
+		bool HasRenderThread() const
+		{
+			return renderThread_.joinable();
+		}
+		RenderThreadStats GetRenderThreadStats() const;
+
+		// Topmost visible widget at (x, y), or nullptr
+		Widget* HitTest(float x, float y);
+
+		// Bounds, visibility and paint order of every widget in the window
+		const WidgetStore& GetWidgetStore() const
+		{
+			return store_;
+		}
+
+		// Renders on the next loop iteration even if no widget is invalidated,
+		// e.g. for animations
+		void RequestFrame()
+		{
+			frameRequested_ = true;
+		}
+
+		// Queues a task to run on the UI thread and wakes the loop. These and
+		// QueueEvent() are the only Window methods that may be called from
+		// other threads; the queue is lock-free.
+		void Post(std::function<void()> task)
+		{
+			Post(kNoPostKey, std::move(task));
+		}
+		// Same, but a task still queued under the same key is dropped for this
+		// one, so e.g. a solver's 10k updates of one value between two frames
+		// run once. Keys are the caller's, such as a widget's address mixed
+		// with a property id.
+		void Post(PostKey key, std::function<void()> task);
+
+		// Time each loop iteration may spend on posted tasks before input and
+		// drawing get their turn; the rest wait for the next iteration
+		void SetPostBudget(std::chrono::microseconds budget)
+		{
+			postBudget_ = budget;
+		}
+		PostQueueStats GetPostStats() const
+		{
+			return posts_.GetStats();
+		}
+
+		// Calls callback on the UI thread every interval (once if !repeat).
+		// Timers drive the loop's wait timeout, so they cost nothing between
+		// firings.
+		TimerId SetTimer(std::chrono::milliseconds interval, std::function<void()> callback, bool repeat = true);
+		void KillTimer(TimerId id);
+
 		// Check if window should close
 		bool ShouldClose() const;
 
@@ -46,19 +192,111 @@ namespace SnowUI
 			return backend_;
 		}
 
-		// Event callbacks
-		void SetOnClose(std::function<void()> callback)
+		// Pixels the backend actually redrew in the last Render(). With a
+		// render thread, the pixels damaged rather than redrawn.
+		const FrameStats& GetLastFrameStats() const
+		{
+			return frameStats_;
+		}
+		// FrameStats::renderTimeUs of every Render() since the last reset
+		const TimeHistogram& GetFrameTimes() const
 		{
-			onClose_ = callback;
+			return frameTimes_;
 		}
+		void ResetFrameTimes()
+		{
+			frameTimes_ = TimeHistogram();
+		}
+
+		// Emitted by Close()
+		Signal<>& GetCloseSignal()
+		{
+			return close_;
+		}
+		// Sets the one callback SetOnClose() manages, replacing the previous one
+		void SetOnClose(Delegate<void()> callback);
 
 	  protected:
+		using Clock = std::chrono::steady_clock;
+
+		struct Timer
+		{
+			TimerId id;
+			Clock::time_point due;
+			Clock::duration interval;
+			bool repeat;
+			std::function<void()> callback;
+		};
+
+		// A recorded frame on its way to the render thread
+		struct RenderFrame
+		{
+			DrawList drawList;
+			DamageRegion damage;
+			int width = 0;
+			int height = 0;
+			uint64_t sequence = 0;
+		};
+
+		void OnDamage(const Rect& rect) override;
+		void OnDescendantAttached(Widget& child) override;
+		void OnDescendantMoved(Widget& widget) override;
+		void OnVisibilityChanged(Widget& widget) override;
+
+		bool NeedsFrame() const;
+		bool HasRecordedFrame() const;
+		// Seconds until the next timer is due; negative if there is none
+		double GetWaitTimeout() const;
+		void RunPostedTasks();
+		void RunTimers();
+		// Dispatches everything queued since the last call
+		void DispatchQueuedEvents();
+		void OnResize(int width, int height);
+		void UpdateLayout();
+		void PublishFrame();
+		void RenderThreadLoop(uint64_t sequence, int width, int height);
+
+		WidgetArena arena_;
 		std::string title_;
 		IRenderBackend* backend_;
-		DrawList drawList_;
+		DamageRegion damage_;
+		FrameStats frameStats_;
+		TimeHistogram frameTimes_;
 		bool shouldClose_;
 		bool hasWindow_;
-		std::function<void()> onClose_;
+		Signal<> close_;
+		ConnectionId onClose_;
+		bool frameRequested_;
+		std::shared_ptr<Layout> layout_;
+		ThreadPool* layoutPool_;
+		bool layoutRunning_;
+		std::vector<WidgetSlot> movedSlots_; // moved by the running layout
+		ThreadPool* paintPool_;
+		DrawChain frameChain_; // clearList_, then the widget tree's chain
+		DrawList clearList_;
+
+		TripleBuffer<RenderFrame> frames_;
+		std::thread renderThread_;
+		std::mutex renderMutex_;
+		std::condition_variable renderWake_;
+		bool renderStopping_;
+		uint64_t frameSequence_;
+		RenderThreadStats renderStats_; // but for presented, UI thread only
+		std::atomic<uint64_t> presentedFrames_;
+
+		WidgetStore store_;
+		HitTestGrid hitGrid_;
+		Widget* mouseCapture_; // receives mouse events from MouseDown to MouseUp
+		Widget* focus_;		   // receives key events
+		std::vector<Widget*> eventPath_;
+		EventQueue eventQueue_;
+		std::vector<Event> eventBatch_;
+
+		std::vector<Timer> timers_;
+		TimerId nextTimerId_;
+
+		PostQueue posts_;
+		std::chrono::microseconds postBudget_;
 	};
 
 } // namespace SnowUI
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "../Core/Widget.h"
+#include "../Core/ThreadPool.h"
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace SnowUI
 {
@@ -11,21 +14,177 @@ namespace SnowUI
 		Vertical,
 		Horizontal,
 		Grid,
+		Dock,
 	};
 
+	// Edge a Dock item is attached to; Fill items take what is left
+	enum class DockSide : uint8_t
+	{
+		Left,
+		Top,
+		Right,
+		Bottom,
+		Fill,
+	};
+
+	// Width of a Grid column or height of a Grid row
+	struct GridLength
+	{
+		enum class Unit : uint8_t
+		{
+			Auto,  // largest item in the track
+			Pixel, // fixed
+			Star,  // share of the space left after Auto and Pixel tracks
+		};
+
+		Unit unit;
+		float value;
+
+		static GridLength Auto()
+		{
+			return {Unit::Auto, 0.0f};
+		}
+		static GridLength Pixel(float pixels)
+		{
+			return {Unit::Pixel, pixels};
+		}
+		static GridLength Star(float weight = 1.0f)
+		{
+			return {Unit::Star, weight};
+		}
+	};
+
+	// How a layout places one of its items
+	struct LayoutParams
+	{
+		float width = -1.0f; // fixed size; negative uses the measured size
+		float height = -1.0f;
+		// Share of the leftover space along a Vertical or Horizontal layout.
+		// When no item stretches, the leftover is split evenly.
+		float stretch = 0.0f;
+		int row = 0; // Grid cell
+		int column = 0;
+		int rowSpan = 1;
+		int columnSpan = 1;
+		DockSide dock = DockSide::Fill;
+	};
+
+	// Node of a layout tree that sizes and places widgets and nested layouts.
+	//
+	// Layout runs in two passes. Measure() computes the size each node wants
+	// from its content alone (text, fixed sizes, nested nodes), and Arrange()
+	// hands out the space of a rect top-down. Both results are cached per
+	// node: Measure() only revisits nodes below an InvalidateMeasure(), and
+	// Arrange() skips every subtree whose rect and content are unchanged, so
+	// after a label's text changes only the path to it is relaid out, and a
+	// resize that leaves a panel's rect alone does not touch its contents.
+	//
+	// Widgets are positioned with SetBounds() and must still be attached to a
+	// parent widget to be painted. Only Widget::SetText() invalidates the
+	// measure automatically; widgets whose OnMeasure() depends on other state
+	// call InvalidateMeasure() themselves.
+	//
+	// Given a ThreadPool, both passes fan out over nested layouts, in runs of
+	// siblings worth about kParallelGrain items per task. Sibling subtrees
+	// only read their own items, and a node's float math does not depend on
+	// the thread running it, so the rects match a serial run bit for bit.
+	// OnMeasure() may then run on pool threads and must only read its widget.
+	// Widgets are still moved afterwards on the calling thread, in the same
+	// order as a serial run.
 	class Layout
 	{
 	  public:
 		Layout(LayoutType type);
-		virtual ~Layout() = default;
+		virtual ~Layout();
+
+		Layout(const Layout&) = delete;
+		Layout& operator=(const Layout&) = delete;
 
-		void AddWidget(std::shared_ptr<Widget> widget);
-		void DoLayout(const Rect& bounds);
+		void AddWidget(std::shared_ptr<Widget> widget, const LayoutParams& params = LayoutParams());
+		// Adds a widget owned elsewhere, e.g. by a WidgetArena
+		void AddWidget(Widget* widget, const LayoutParams& params = LayoutParams());
+		void AddLayout(std::shared_ptr<Layout> layout, const LayoutParams& params = LayoutParams());
+
+		void SetSpacing(float spacing);
+		// Space kept free inside the edges of the layout's rect
+		void SetPadding(float padding);
+		// Tracks of a Grid layout; without any, the grid is one Star track
+		void SetColumns(std::vector<GridLength> columns);
+		void SetRows(std::vector<GridLength> rows);
+
+		static constexpr size_t kParallelGrain = 256;
+
+		// Measures what changed and arranges everything inside bounds
+		void DoLayout(const Rect& bounds, ThreadPool* pool = nullptr);
+
+		// Size this node wants, padding included
+		const Size& Measure(ThreadPool* pool = nullptr);
+		void Arrange(const Rect& bounds, ThreadPool* pool = nullptr);
+
+		// Marks this node and its ancestors for re-measuring, e.g. after an
+		// item's content changed
+		void InvalidateMeasure();
+
+		bool IsLayoutPending() const
+		{
+			return measureDirty_ || arrangeDirty_;
+		}
+		const Rect& GetArrangedRect() const
+		{
+			return arranged_;
+		}
 
 	  private:
+		struct Item
+		{
+			Widget* widget = nullptr;
+			std::shared_ptr<Widget> ownedWidget;
+			std::shared_ptr<Layout> layout;
+			LayoutParams params;
+			Size desired;
+			Rect rect; // as last arranged
+		};
+
+		void AddItem(Item item);
+		void MeasureItem(Item& item);
+		// Computes the rects of this subtree without touching any widget
+		void ArrangeTree(const Rect& bounds, ThreadPool* pool);
+		// Moves the widgets whose rects ArrangeTree() changed
+		void ApplyBounds();
+		// Calls fn for every nested layout item, on pool tasks if it is worth it
+		template <typename Fn> void ForEachChildLayout(ThreadPool* pool, Fn&& fn);
+
+		Size MeasureStack(bool vertical) const;
+		void ArrangeStack(const Rect& content, bool vertical);
+		Size MeasureGrid();
+		void ArrangeGrid(const Rect& content);
+		Size MeasureDock() const;
+		void ArrangeDock(const Rect& content);
+
+		// Sizes the tracks of one axis to fill length and stores where each
+		// starts; offsets gets one entry per track plus the end
+		void ResolveTracks(const std::vector<GridLength>& tracks, const std::vector<float>& measured, float length,
+		                   std::vector<float>& offsets) const;
+
 		LayoutType type_;
-		std::vector<std::shared_ptr<Widget>> widgets_;
-		int spacing_;
+		std::vector<Item> items_;
+		std::vector<size_t> childLayouts_; // indices of nested layout items
+		size_t subtreeSize_;				 // items in this node and below
+		float spacing_;
+		float padding_;
+		std::vector<GridLength> columns_;
+		std::vector<GridLength> rows_;
+		std::vector<float> columnSizes_; // measured Auto/Pixel/Star sizes
+		std::vector<float> rowSizes_;
+		std::vector<float> columnOffsets_;
+		std::vector<float> rowOffsets_;
+
+		Layout* parent_;
+		Size desired_;
+		Rect arranged_;
+		bool measureDirty_;
+		bool arrangeDirty_;
+		bool applyPending_;
 	};
 
 } // namespace SnowUI
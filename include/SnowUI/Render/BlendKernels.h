@@ -0,0 +1,55 @@
+#pragma once
+
+#include "DrawCommand.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace SnowUI
+{
+
+	// Pixel kernels for CPU compositing into RGBA8 framebuffers.
+	//
+	// Pixels are 32-bit values whose bytes are R, G, B, A in memory order and
+	// whose color channels are premultiplied by alpha. All kernels implement
+	// source-over with exact round(x / 255) arithmetic, so every ISA variant
+	// produces results bit-identical to the scalar reference.
+
+	enum class BlendISA
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		NEON,
+	};
+
+	struct BlendKernels
+	{
+		BlendISA isa;
+
+		// dst[i] = src
+		void (*fillSolid)(uint32_t* dst, size_t count, uint32_t src);
+
+		// dst[i] = src over dst[i]
+		void (*blendSolid)(uint32_t* dst, size_t count, uint32_t src);
+
+		// dst[i] = (src * coverage[i]) over dst[i]
+		void (*blendMask)(uint32_t* dst, const uint8_t* coverage, size_t count, uint32_t src);
+	};
+
+	// Best kernel set supported by the running CPU, detected once
+	const BlendKernels& GetBlendKernels();
+
+	// Kernel set for a specific ISA; falls back to Scalar when the ISA was not
+	// compiled in or is not supported by the running CPU
+	const BlendKernels& GetBlendKernels(BlendISA isa);
+
+	const char* GetBlendISAName(BlendISA isa);
+
+	// Converts a straight-alpha float color to a premultiplied RGBA8 pixel:
+	// each channel is rounded to 8 bits first, then multiplied by alpha.
+	uint32_t ColorToPremultipliedRGBA8(const Color& color);
+
+	// Batch form of ColorToPremultipliedRGBA8, vectorized where available
+	void ColorsToPremultipliedRGBA8(const Color* colors, uint32_t* out, size_t count);
+
+} // namespace SnowUI
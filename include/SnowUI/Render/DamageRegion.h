@@ -0,0 +1,108 @@
+#pragma once
+
+#include "DrawCommand.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace SnowUI
+{
+
+	// Integer pixel rectangle, top-left origin
+	struct DamageRect
+	{
+		int x, y, width, height;
+
+		int Right() const
+		{
+			return x + width;
+		}
+		int Bottom() const
+		{
+			return y + height;
+		}
+	};
+
+	// Set of screen areas that changed since the previous frame.
+	//
+	// Rects are kept pairwise disjoint: a rect that overlaps an existing one is
+	// merged into it, so redrawing each rect once never blends a pixel twice.
+	// Past kMaxRects the whole set collapses into its bounding box, which
+	// bounds the per-rect overhead backends pay (one scissor pass each).
+	class DamageRegion
+	{
+	  public:
+		static constexpr size_t kMaxRects = 8;
+
+		// Empties the region and sets the surface it is clipped to
+		void Reset(int width, int height);
+
+		// Adds the pixels touched by a float rect, rounded outwards
+		void Add(const Rect& rect);
+		void Add(const DamageRect& rect);
+		void Add(const DamageRegion& other);
+		void AddAll();
+
+		bool IsEmpty() const
+		{
+			return rects_.empty();
+		}
+		bool IsFull() const;
+
+		const std::vector<DamageRect>& GetRects() const
+		{
+			return rects_;
+		}
+		uint64_t GetArea() const;
+
+		int GetWidth() const
+		{
+			return width_;
+		}
+		int GetHeight() const
+		{
+			return height_;
+		}
+
+	  private:
+		int width_ = 0;
+		int height_ = 0;
+		std::vector<DamageRect> rects_;
+	};
+
+	// Damage of the last few frames, for swap chains that hand back a buffer
+	// last drawn several frames ago. With a buffer age of N, a frame must
+	// also redraw what changed in the previous N - 1 frames.
+	class DamageHistory
+	{
+	  public:
+		// 0 disables partial redraw: every frame is drawn in full
+		void SetBufferAge(int age)
+		{
+			bufferAge_ = age;
+			Reset();
+		}
+		int GetBufferAge() const
+		{
+			return bufferAge_;
+		}
+
+		// Drops history, e.g. after a resize, so the next frames redraw fully
+		void Reset()
+		{
+			frames_.clear();
+			fullFramesLeft_ = bufferAge_;
+		}
+
+		// Records this frame's damage and widens it to cover the buffer's age
+		void Accumulate(DamageRegion& damage);
+
+	  private:
+		int bufferAge_ = 0;
+		int fullFramesLeft_ = 0;
+		int width_ = 0;
+		int height_ = 0;
+		std::deque<DamageRegion> frames_;
+	};
+
+} // namespace SnowUI
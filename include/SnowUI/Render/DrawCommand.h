@@ -1,13 +1,16 @@
 #pragma once
 
+#include "Font.h"
 #include <vector>
 #include <string>
+#include <string_view>
 #include <cstdint>
+#include <type_traits>
 
 namespace SnowUI
 {
 
-	enum class DrawCommandType
+	enum class DrawCommandType : uint8_t
 	{
 		Clear,
 		DrawRect,
@@ -39,24 +42,60 @@ namespace SnowUI
 		}
 	};
 
+	struct Size
+	{
+		float width, height;
+
+		Size() : width(0), height(0)
+		{
+		}
+		Size(float w, float h) : width(w), height(h)
+		{
+		}
+	};
+
+	// A single recorded command. Commands are plain data so a DrawList can be
+	// grown, copied and cleared without touching the heap once warmed up.
+	// Text is not stored inline: DrawText commands reference a slice of the
+	// owning DrawList's text arena (see DrawList::GetText).
 	struct DrawCommand
 	{
 		DrawCommandType type;
 		Rect rect;
 		Color color;
-		std::string text;
+		uint32_t textOffset;
+		uint32_t textLength;
+		FontId font;
+		uint16_t fontSize;
 
-		DrawCommand(DrawCommandType t) : type(t)
+		DrawCommand()
+			: type(DrawCommandType::Clear), textOffset(0), textLength(0), font(kDefaultFont),
+			  fontSize(kDefaultFontSize)
+		{
+		}
+		DrawCommand(DrawCommandType t)
+			: type(t), textOffset(0), textLength(0), font(kDefaultFont), fontSize(kDefaultFontSize)
 		{
 		}
 	};
 
+	static_assert(std::is_trivially_copyable<DrawCommand>::value, "DrawCommand must stay trivially copyable");
+
 	class DrawList
 	{
 	  public:
+		// Drops all commands and text but keeps the allocated capacity, so a
+		// list that is re-recorded every frame stops allocating after warm-up.
 		void Clear()
 		{
 			commands_.clear();
+			textArena_.clear();
+		}
+
+		void Reserve(size_t commandCount, size_t textBytes)
+		{
+			commands_.reserve(commandCount);
+			textArena_.reserve(textBytes);
 		}
 
 		void AddClear(const Color& color)
@@ -74,10 +113,16 @@ namespace SnowUI
 			commands_.push_back(cmd);
 		}
 
-		void AddText(const std::string& text, float x, float y, const Color& color)
+		// (x, y) is the top-left corner of the text line
+		void AddText(std::string_view text, float x, float y, const Color& color, FontId font = kDefaultFont,
+		             uint16_t fontSize = kDefaultFontSize)
 		{
 			DrawCommand cmd(DrawCommandType::DrawText);
-			cmd.text = text;
+			cmd.font = font;
+			cmd.fontSize = fontSize;
+			cmd.textOffset = static_cast<uint32_t>(textArena_.size());
+			cmd.textLength = static_cast<uint32_t>(text.size());
+			textArena_.insert(textArena_.end(), text.begin(), text.end());
 			cmd.rect.x = x;
 			cmd.rect.y = y;
 			cmd.color = color;
@@ -97,13 +142,124 @@ namespace SnowUI
 			commands_.push_back(cmd);
 		}
 
+		// Appends every command of another list, copying its text and rebasing
+		// the text offsets into this list's arena
+		void Append(const DrawList& other)
+		{
+			const size_t first = commands_.size();
+			const uint32_t textBase = static_cast<uint32_t>(textArena_.size());
+			commands_.insert(commands_.end(), other.commands_.begin(), other.commands_.end());
+			if (other.textArena_.empty())
+				return;
+
+			textArena_.insert(textArena_.end(), other.textArena_.begin(), other.textArena_.end());
+			for (size_t i = first; i < commands_.size(); ++i)
+			{
+				if (commands_[i].type == DrawCommandType::DrawText)
+					commands_[i].textOffset += textBase;
+			}
+		}
+
 		const std::vector<DrawCommand>& GetCommands() const
 		{
 			return commands_;
 		}
 
+		// Returns the text referenced by a DrawText command recorded into this list.
+		// The view is valid until the list is cleared or more text is added.
+		std::string_view GetText(const DrawCommand& cmd) const
+		{
+			if (cmd.textLength == 0)
+				return std::string_view();
+			return std::string_view(textArena_.data() + cmd.textOffset, cmd.textLength);
+		}
+
+		size_t GetTextArenaSize() const
+		{
+			return textArena_.size();
+		}
+
 	  private:
 		std::vector<DrawCommand> commands_;
+		std::vector<char> textArena_;
+	};
+
+	// DrawLists drawn one after another as if they were a single list. A
+	// chain can also link other chains, which are walked in place when it is
+	// drawn: each widget chains its own list and its children's chains, so a
+	// frame is assembled from per-widget recordings without copying any of
+	// them. Lists and chains are referenced, so they must outlive the chain's
+	// use.
+	class DrawChain
+	{
+	  public:
+		void Clear()
+		{
+			links_.clear();
+		}
+
+		void Add(const DrawList& list)
+		{
+			if (!list.GetCommands().empty())
+				links_.push_back(Link{&list, nullptr});
+		}
+
+		// Links chain as it is when this one is walked, not as it is now
+		void Add(const DrawChain& chain)
+		{
+			links_.push_back(Link{nullptr, &chain});
+		}
+
+		// Calls fn for every non-empty list, nested chains included, in order
+		template <typename F> void ForEachList(F&& fn) const
+		{
+			for (const Link& link : links_)
+			{
+				if (link.list)
+					fn(*link.list);
+				else
+					link.chain->ForEachList(fn);
+			}
+		}
+
+		bool IsEmpty() const
+		{
+			for (const Link& link : links_)
+			{
+				if (link.list || !link.chain->IsEmpty())
+					return false;
+			}
+			return true;
+		}
+
+		size_t GetCommandCount() const
+		{
+			size_t count = 0;
+			ForEachList([&count](const DrawList& list) { count += list.GetCommands().size(); });
+			return count;
+		}
+
+		// Appends the whole chain to out, e.g. for a backend that needs one list
+		void AppendTo(DrawList& out) const
+		{
+			ForEachList([&out](const DrawList& list) { out.Append(list); });
+		}
+
+		void Flatten(DrawList& out) const
+		{
+			out.Clear();
+			AppendTo(out);
+		}
+
+	  private:
+		// Exactly one of the two is set
+		struct Link
+		{
+			const DrawList* list;
+			const DrawChain* chain;
+		};
+
+		std::vector<Link> links_;
 	};
 
 } // namespace SnowUI
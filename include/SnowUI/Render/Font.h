@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SnowUI
+{
+
+	using FontId = uint16_t;
+
+	// Font 0 is always available. It draws every visible character as a solid
+	// box, so text has a size and position even without a font file or FreeType.
+	static constexpr FontId kDefaultFont = 0;
+	static constexpr FontId kInvalidFont = 0xFFFF;
+	static constexpr uint16_t kDefaultFontSize = 12;
+
+	struct GlyphBitmap
+	{
+		int width;
+		int height;
+		int bearingX; // from pen position to left edge
+		int bearingY; // from baseline up to top edge
+		float advance;
+		std::vector<uint8_t> coverage; // width * height, row-major
+	};
+
+	struct FontMetrics
+	{
+		float ascent;	  // baseline distance from the top of a line
+		float lineHeight; // distance between consecutive baselines
+	};
+
+	// Process-wide registry of loaded font faces. Glyph rasterization goes
+	// through FreeType when SnowUI is built with SNOWUI_FREETYPE_ENABLED.
+	// All methods are thread-safe.
+	class FontRegistry
+	{
+	  public:
+		static FontRegistry& Instance();
+
+		~FontRegistry();
+
+		// Loads a TrueType/OpenType file; returns kInvalidFont on failure
+		FontId LoadFont(const std::string& path);
+
+		FontMetrics GetMetrics(FontId font, uint16_t size);
+		float GetAdvance(FontId font, uint16_t size, uint32_t codepoint);
+		bool RasterizeGlyph(FontId font, uint16_t size, uint32_t codepoint, GlyphBitmap& out);
+
+		// Incremented whenever the set of fonts changes, so caches of derived
+		// data (glyphs, measurements) can tell when they are stale. Lock-free,
+		// as caches check it on every lookup.
+		uint32_t GetGeneration() const
+		{
+			return generation_.load(std::memory_order_acquire);
+		}
+
+	  private:
+		FontRegistry();
+
+		struct Face;
+
+		// Returns nullptr for the built-in font or an unknown id
+		Face* FindFace(FontId font);
+		bool SelectSize(Face* face, uint16_t size);
+
+		mutable std::mutex mutex_;
+		void* library_; // FT_Library
+		std::vector<std::unique_ptr<Face>> faces_;
+		std::atomic<uint32_t> generation_;
+	};
+
+	// Decodes one UTF-8 sequence starting at text[i] and advances i past it.
+	// Malformed input decodes to U+FFFD one byte at a time.
+	inline uint32_t DecodeUTF8(std::string_view text, size_t& i)
+	{
+		const uint8_t c = static_cast<uint8_t>(text[i++]);
+		if (c < 0x80)
+			return c;
+
+		int extra = 0;
+		uint32_t cp = 0;
+		if ((c & 0xE0) == 0xC0)
+		{
+			extra = 1;
+			cp = c & 0x1F;
+		}
+		else if ((c & 0xF0) == 0xE0)
+		{
+			extra = 2;
+			cp = c & 0x0F;
+		}
+		else if ((c & 0xF8) == 0xF0)
+		{
+			extra = 3;
+			cp = c & 0x07;
+		}
+		else
+		{
+			return 0xFFFD;
+		}
+
+		if (i + extra > text.size())
+		{
+			i = text.size();
+			return 0xFFFD;
+		}
+		for (int k = 0; k < extra; ++k)
+		{
+			const uint8_t cc = static_cast<uint8_t>(text[i]);
+			if ((cc & 0xC0) != 0x80)
+				return 0xFFFD;
+			cp = (cp << 6) | (cc & 0x3F);
+			++i;
+		}
+		return cp;
+	}
+
+} // namespace SnowUI
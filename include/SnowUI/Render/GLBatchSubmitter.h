@@ -0,0 +1,49 @@
+#pragma once
+
+#include "SnowUI/Render/GeometryBatcher.h"
+#include <cstddef>
+
+namespace SnowUI
+{
+
+	// Draws GeometryBatcher output through the fixed-function pipeline of a
+	// GL 1.5 compatibility context, for OpenGLBackend and SkiaBackend's GL
+	// fallback. Upload() streams the frame's vertices and indices into buffer
+	// objects once; Draw() then issues one glDrawElements per batch and can
+	// be repeated, e.g. once per damage rect under a scissor box.
+	class GLBatchSubmitter
+	{
+	  public:
+		GLBatchSubmitter();
+
+		// Creates the glyph atlas texture and buffer objects and sets up
+		// blending and the projection. The context must be current. Returns
+		// false when buffer objects are not available; nothing is drawn then.
+		bool Create(GlyphCache* glyphCache, int width, int height);
+		// Releases the GL objects; the context must still be current
+		void Destroy();
+
+		bool IsCreated() const
+		{
+			return created_;
+		}
+
+		// Viewport and orthographic projection with a top-left origin
+		void SetViewport(int width, int height);
+
+		// Uploads the atlas region the batcher dirtied and the batch geometry
+		void Upload(const GeometryBatcher& batcher);
+		// Draws the batches of the last Upload()
+		void Draw(const GeometryBatcher& batcher);
+
+	  private:
+		GlyphCache* glyphCache_;
+		unsigned int atlasTexture_;
+		unsigned int vertexBuffer_;
+		unsigned int indexBuffer_;
+		size_t vertexCapacity_; // in bytes
+		size_t indexCapacity_;	// in bytes
+		bool created_;
+	};
+
+} // namespace SnowUI
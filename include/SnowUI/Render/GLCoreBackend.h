@@ -0,0 +1,102 @@
+#pragma once
+
+#include "SnowUI/Render/IRenderBackend.h"
+#include "SnowUI/Render/GeometryBatcher.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace SnowUI
+{
+
+	// GLCoreBackend renders through an OpenGL 3.3 core profile context.
+	// GeometryBatcher::BuildInstances turns every rect, line and glyph quad
+	// into one instance of a unit quad that is expanded in the vertex shader,
+	// so a frame is a handful of instanced draw calls fed from a single
+	// orphaned instance buffer. All instances
+	// sample the glyph atlas, so text and geometry share one batch. The
+	// projection is a shader uniform rather than fixed-function matrix state.
+	//
+	// With SetOffscreen(true) the context is created on a hidden window, which
+	// lets the renderer run headless (e.g. Xvfb + Mesa llvmpipe) and read the
+	// result back with ReadPixels().
+	class GLCoreBackend : public IRenderBackend
+	{
+	  public:
+		GLCoreBackend();
+		virtual ~GLCoreBackend();
+
+		bool Initialize(int width, int height) override;
+		void Shutdown() override;
+		void BeginFrame() override;
+		void EndFrame() override;
+		void ExecuteDrawList(const DrawList& drawList) override;
+		void ExecuteDrawListPartial(const DrawList& drawList, DamageRegion& damage) override;
+		void ExecuteDrawChainPartial(const DrawChain& chain, DamageRegion& damage) override;
+		void Resize(int width, int height) override;
+		GlyphCache* GetGlyphCache() override
+		{
+			return &glyphCache_;
+		}
+
+		// Window management
+		bool CreateWindow(const std::string& title, int width, int height) override;
+		void DestroyWindow() override;
+		bool ShouldClose() override;
+		void PollEvents() override;
+		bool WaitEvents(double timeoutSeconds) override;
+		void PostEmptyEvent() override;
+		void SetEventQueue(EventQueue* queue) override;
+		void SwapBuffers() override;
+		void* GetNativeWindowHandle() override;
+		void SetDetachedRendering(bool detached) override;
+		void MakeContextCurrent(bool current) override;
+
+		// How many frames old the back buffer is after a swap; see DamageHistory.
+		// 0 (the default) redraws every frame in full. An offscreen context
+		// keeps its buffer, so 1 is safe there.
+		void SetBufferAge(int age)
+		{
+			damageHistory_.SetBufferAge(age);
+		}
+
+		// Must be called before CreateWindow to take effect
+		void SetOffscreen(bool offscreen)
+		{
+			offscreen_ = offscreen;
+		}
+
+		// Reads the current back buffer as tightly packed RGBA8 rows, top row first
+		bool ReadPixels(std::vector<uint8_t>& pixels);
+
+	  private:
+		bool CreatePipeline();
+		void DestroyPipeline();
+		void UpdateProjection();
+		bool UploadInstances();
+		void DrawBatches();
+		// Uploads batcher_'s instances and draws them inside damage
+		void SubmitPartial(DamageRegion& damage);
+		void UploadAtlas();
+
+		int width_;
+		int height_;
+		bool initialized_;
+		EventQueue* eventQueue_;
+		void* window_; // GLFW window handle
+		bool ownsWindow_;
+		bool detached_; // drawing runs on a render thread
+		bool offscreen_;
+
+		unsigned int program_;
+		unsigned int vao_;
+		unsigned int instanceBuffer_;
+		size_t instanceCapacity_; // in bytes
+		int projectionLocation_;
+		unsigned int atlasTexture_;
+		GlyphCache glyphCache_;
+		GeometryBatcher batcher_;
+		DamageHistory damageHistory_;
+	};
+
+} // namespace SnowUI
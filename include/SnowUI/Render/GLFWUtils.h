@@ -3,6 +3,8 @@
 namespace SnowUI
 {
 
+	class EventQueue;
+
 	// GLFW initialization utilities shared across backends
 	// These functions manage GLFW reference counting to ensure proper initialization
 	// and termination when multiple backend instances are created.
@@ -10,4 +12,21 @@ namespace SnowUI
 	bool InitializeGLFW();
 	void TerminateGLFW();
 
+	// Processes events, blocking until one arrives or the timeout (seconds;
+	// negative waits indefinitely) expires
+	void WaitGLFWEvents(double timeoutSeconds);
+
+	// Wakes a thread blocked in WaitGLFWEvents; callable from any thread and
+	// a no-op while GLFW is not initialized
+	void PostGLFWEmptyEvent();
+
+	// Makes window's GL context current on the calling thread; nullptr
+	// releases the calling thread's context
+	void MakeGLFWContextCurrent(void* window);
+
+	// Installs input callbacks on a GLFW window that translate mouse, wheel,
+	// key and framebuffer-size input into Events pushed onto queue. Passing
+	// nullptr removes them. Uses the window's user pointer.
+	void AttachGLFWEventQueue(void* window, EventQueue* queue);
+
 } // namespace SnowUI
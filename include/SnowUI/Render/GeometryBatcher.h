@@ -0,0 +1,116 @@
+#pragma once
+
+#include "DrawCommand.h"
+#include "GlyphCache.h"
+#include <vector>
+#include <cstdint>
+
+namespace SnowUI
+{
+
+	// Converts a [0, 1] color channel to an 8-bit value with rounding
+	inline uint8_t ColorToByte(float v)
+	{
+		if (v <= 0.0f)
+			return 0;
+		if (v >= 1.0f)
+			return 255;
+		return static_cast<uint8_t>(v * 255.0f + 0.5f);
+	}
+
+	struct BatchVertex
+	{
+		float x, y;
+		float u, v; // normalized glyph atlas coordinates
+		uint8_t r, g, b, a;
+	};
+
+	// One quad for instanced drawing, expanded from a unit quad by the backend
+	struct BatchInstance
+	{
+		float x0, y0, x1, y1; // corners; start and end point for lines
+		float u0, v0, u1, v1; // glyph atlas rect; the white texel for untextured quads
+		uint8_t r, g, b, a;
+		float lineWidth; // 0 for filled rects and glyphs, > 0 for lines
+	};
+
+	enum class BatchType : uint8_t
+	{
+		Clear,	   // clear the target to clearColor, no geometry
+		Triangles, // indexed triangle list, or a run of instances
+	};
+
+	struct DrawBatch
+	{
+		BatchType type;
+		uint32_t first; // first index after Build(), first instance after BuildInstances()
+		uint32_t count;
+		Color clearColor;
+	};
+
+	// Converts a DrawList, or the lists of a DrawChain, into packed arrays that a backend can submit with
+	// one draw call per batch: vertices and indices with Build(), or one
+	// instance per quad with BuildInstances(). Rects, glyphs and lines all
+	// become quads sampling the same glyph atlas (untextured quads point at
+	// its white texel), so consecutive commands merge into a single batch;
+	// only Clear commands split batches, keeping painter's order intact.
+	// Buffers are reused between calls and stop allocating once warmed up.
+	class GeometryBatcher
+	{
+	  public:
+		GeometryBatcher() : glyphCache_(nullptr), whiteUV_(0.0f), instanced_(false)
+		{
+		}
+
+		// Text is only emitted once a glyph cache is attached
+		void SetGlyphCache(GlyphCache* glyphCache)
+		{
+			glyphCache_ = glyphCache;
+		}
+
+		void Build(const DrawList& drawList);
+		void BuildInstances(const DrawList& drawList);
+		// The lists of a chain batch together as if they were one list
+		void Build(const DrawChain& chain);
+		void BuildInstances(const DrawChain& chain);
+
+		const std::vector<BatchVertex>& GetVertices() const
+		{
+			return vertices_;
+		}
+		const std::vector<uint32_t>& GetIndices() const
+		{
+			return indices_;
+		}
+		const std::vector<BatchInstance>& GetInstances() const
+		{
+			return instances_;
+		}
+		const std::vector<DrawBatch>& GetBatches() const
+		{
+			return batches_;
+		}
+
+	  private:
+		template <bool Instanced> void Begin();
+		template <bool Instanced> void AddCommands(const DrawList& drawList);
+		void AddQuad(float x0, float y0, float x1, float y1, const Color& color);
+		void AddGlyphQuad(const GlyphQuad& quad, const Color& color);
+		void AddLineQuad(float x1, float y1, float x2, float y2, const Color& color);
+		void AddQuadVertices(const float* xy, const float* uv, const Color& color);
+		void AddInstance(float x0, float y0, float x1, float y1, const Color& color, float lineWidth);
+		void AddGlyphInstance(const GlyphQuad& quad, const Color& color);
+		uint32_t GetEmittedCount() const;
+		void EnsureTriangleBatch();
+		void CloseBatch();
+
+		std::vector<BatchVertex> vertices_;
+		std::vector<uint32_t> indices_;
+		std::vector<BatchInstance> instances_;
+		std::vector<DrawBatch> batches_;
+		GlyphCache* glyphCache_;
+		float whiteUV_;
+		bool instanced_; // which arrays the current build fills
+	};
+
+} // namespace SnowUI
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Font.h"
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace SnowUI
+{
+
+	// Location and metrics of a glyph resident in the atlas
+	struct CachedGlyph
+	{
+		uint16_t x, y;			// top-left texel in the atlas
+		uint16_t width, height; // 0 for blank glyphs such as space
+		int16_t bearingX;
+		int16_t bearingY;
+		float advance;
+	};
+
+	// Screen-space placement of one glyph of a laid out text run
+	struct GlyphQuad
+	{
+		float x0, y0, x1, y1;
+		const CachedGlyph* glyph;
+	};
+
+	struct GlyphCacheStats
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+		uint64_t overflows = 0; // glyphs that could not be placed this frame
+		size_t glyphCount = 0;
+		size_t usedTexels = 0;
+		size_t atlasTexels = 0;
+
+		double HitRate() const
+		{
+			uint64_t total = hits + misses;
+			return total ? static_cast<double>(hits) / total : 0.0;
+		}
+		double Occupancy() const
+		{
+			return atlasTexels ? static_cast<double>(usedTexels) / atlasTexels : 0.0;
+		}
+	};
+
+	// Single-channel glyph atlas with an LRU cache keyed by (font, size, codepoint).
+	//
+	// Glyphs are rasterized once through FontRegistry and packed into shelves.
+	// When the atlas is full, the least recently used glyphs that were not
+	// touched in the current frame are evicted and their slots reused, so
+	// coordinates handed out during a frame stay valid until it ends.
+	// A small opaque block at the origin (GetWhiteTexel) lets backends draw
+	// untextured geometry with the same texture bound as text.
+	class GlyphCache
+	{
+	  public:
+		explicit GlyphCache(int atlasSize = 1024);
+
+		// Marks the start of a frame; glyphs used after this call are pinned
+		void BeginFrame();
+
+		// Returns the glyph, rasterizing and uploading it on a miss. If it cannot
+		// be placed the result has zero size but a valid advance.
+		const CachedGlyph& GetGlyph(FontId font, uint16_t size, uint32_t codepoint);
+
+		// Lays out a single line of UTF-8 text whose top-left corner is (x, y)
+		// and calls fn(const GlyphQuad&) for every glyph that has pixels.
+		// Quads are snapped to whole pixels so glyphs map 1:1 onto texels.
+		template <typename Fn> void LayoutRun(std::string_view text, FontId font, uint16_t size, float x, float y, Fn&& fn)
+		{
+			const float baseline = std::round(y + FontRegistry::Instance().GetMetrics(font, size).ascent);
+			float penX = x;
+			for (size_t i = 0; i < text.size();)
+			{
+				const CachedGlyph& glyph = GetGlyph(font, size, DecodeUTF8(text, i));
+				if (glyph.width > 0)
+				{
+					GlyphQuad quad;
+					quad.x0 = std::round(penX + glyph.bearingX);
+					quad.y0 = baseline - glyph.bearingY;
+					quad.x1 = quad.x0 + glyph.width;
+					quad.y1 = quad.y0 + glyph.height;
+					quad.glyph = &glyph;
+					fn(quad);
+				}
+				penX += glyph.advance;
+			}
+		}
+
+		int GetAtlasSize() const
+		{
+			return atlasSize_;
+		}
+		const uint8_t* GetAtlasPixels() const
+		{
+			return pixels_.data();
+		}
+
+		// Center of the opaque block, in texels
+		float GetWhiteTexel() const
+		{
+			return 1.0f;
+		}
+
+		// Region modified since the last call; returns false if nothing changed
+		bool TakeDirtyRect(int& x, int& y, int& width, int& height);
+
+		const GlyphCacheStats& GetStats() const
+		{
+			return stats_;
+		}
+		void ResetCounters();
+
+		// Drops every glyph, e.g. after fonts were reloaded
+		void Clear();
+
+	  private:
+		struct Slot
+		{
+			uint16_t x, y, width, height;
+		};
+
+		struct Shelf
+		{
+			int y;
+			int height;
+			int nextX;
+		};
+
+		struct Entry
+		{
+			CachedGlyph glyph;
+			Slot slot;
+			bool hasSlot;
+			uint64_t lastFrame;
+			std::list<uint64_t>::iterator lru;
+		};
+
+		bool Allocate(int width, int height, Slot& slot);
+		bool AllocateFresh(int width, int height, Slot& slot);
+		bool EvictOne();
+		void MarkDirty(int x, int y, int width, int height);
+
+		int atlasSize_;
+		std::vector<uint8_t> pixels_;
+		std::vector<Shelf> shelves_;
+		int nextShelfY_;
+		std::vector<Slot> freeSlots_;
+
+		std::unordered_map<uint64_t, Entry> entries_;
+		std::list<uint64_t> lru_; // front = most recently used
+		uint64_t frame_;
+		uint32_t fontGeneration_;
+
+		GlyphBitmap scratch_;
+		CachedGlyph overflowGlyph_;
+		int dirtyX0_, dirtyY0_, dirtyX1_, dirtyY1_;
+		GlyphCacheStats stats_;
+	};
+
+} // namespace SnowUI
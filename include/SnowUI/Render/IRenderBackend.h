@@ -1,12 +1,16 @@
 #pragma once
 
 #include "DrawCommand.h"
+#include "GlyphCache.h"
+#include "DamageRegion.h"
 #include <memory>
 #include <string>
 
 namespace SnowUI
 {
 
+	class EventQueue;
+
 	class IRenderBackend
 	{
 	  public:
@@ -19,6 +23,32 @@ namespace SnowUI
 		virtual void ExecuteDrawList(const DrawList& drawList) = 0;
 		virtual void Resize(int width, int height) = 0;
 
+		// Redraws only the parts of the frame inside damage; pixels outside it
+		// keep what the previous frame left there. On return damage holds the
+		// region actually redrawn, which may be larger than requested (e.g. the
+		// whole surface after a resize, or when the backend cannot clip).
+		virtual void ExecuteDrawListPartial(const DrawList& drawList, DamageRegion& damage)
+		{
+			ExecuteDrawList(drawList);
+			damage.AddAll();
+		}
+
+		// Same as ExecuteDrawListPartial() for the lists of a chain in order.
+		// Backends that can walk the lists themselves override this; the
+		// default copies them into one list first.
+		virtual void ExecuteDrawChainPartial(const DrawChain& chain, DamageRegion& damage)
+		{
+			DrawList flattened;
+			chain.Flatten(flattened);
+			ExecuteDrawListPartial(flattened, damage);
+		}
+
+		// Glyph atlas used for text, if the backend renders real glyphs
+		virtual GlyphCache* GetGlyphCache()
+		{
+			return nullptr;
+		}
+
 		// Window management - implemented by backends that support windowing
 		virtual bool CreateWindow(const std::string& title, int width, int height)
 		{
@@ -37,9 +67,51 @@ namespace SnowUI
 		virtual void PollEvents()
 		{
 		}
+
+		// Blocks until input arrives, PostEmptyEvent() is called or the timeout
+		// (seconds; negative waits indefinitely) expires, then processes events.
+		// Returns true if the backend needs a frame regardless of widget state,
+		// e.g. because the framebuffer was resized. Backends without a window
+		// do not block.
+		virtual bool WaitEvents(double timeoutSeconds)
+		{
+			(void)timeoutSeconds;
+			PollEvents();
+			return false;
+		}
+
+		// Queue that receives the window's input; set before CreateWindow.
+		// Backends without a window ignore it.
+		virtual void SetEventQueue(EventQueue* queue)
+		{
+			(void)queue;
+		}
+
+		// Wakes a pending WaitEvents(); safe to call from any thread
+		virtual void PostEmptyEvent()
+		{
+		}
 		virtual void SwapBuffers()
 		{
 		}
+
+		// Called on the window thread with true before a render thread takes
+		// over drawing (see Window::SetRenderThread) and with false after it
+		// stopped. While detached, BeginFrame()/Execute*()/EndFrame()/
+		// Resize() run on the render thread only, the window
+		// thread keeps to the window and event methods, and size changes
+		// arrive through Resize() instead of being polled from the window.
+		// Backends with a context release it from the window thread here.
+		virtual void SetDetachedRendering(bool detached)
+		{
+			(void)detached;
+		}
+		// Binds the backend's rendering context to the calling thread, or
+		// unbinds it; the render thread brackets its frames with these
+		virtual void MakeContextCurrent(bool current)
+		{
+			(void)current;
+		}
 		virtual void* GetNativeWindowHandle()
 		{
 			return nullptr;
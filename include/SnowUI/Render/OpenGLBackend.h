@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SnowUI/Render/IRenderBackend.h"
+#include "SnowUI/Render/GLBatchSubmitter.h"
 #include <string>
 
 namespace SnowUI
@@ -17,27 +18,50 @@ namespace SnowUI
 		void BeginFrame() override;
 		void EndFrame() override;
 		void ExecuteDrawList(const DrawList& drawList) override;
+		void ExecuteDrawListPartial(const DrawList& drawList, DamageRegion& damage) override;
+		void ExecuteDrawChainPartial(const DrawChain& chain, DamageRegion& damage) override;
 		void Resize(int width, int height) override;
+		// How many frames old the back buffer is after a swap; see DamageHistory.
+		// GLFW cannot query this, so partial redraw is off (0) until the
+		// application states what its platform's swap chain guarantees.
+		void SetBufferAge(int age)
+		{
+			damageHistory_.SetBufferAge(age);
+		}
+
+		GlyphCache* GetGlyphCache() override
+		{
+			return &glyphCache_;
+		}
 
 		// Window management
 		bool CreateWindow(const std::string& title, int width, int height) override;
 		void DestroyWindow() override;
 		bool ShouldClose() override;
 		void PollEvents() override;
+		bool WaitEvents(double timeoutSeconds) override;
+		void PostEmptyEvent() override;
+		void SetEventQueue(EventQueue* queue) override;
 		void SwapBuffers() override;
 		void* GetNativeWindowHandle() override;
+		void SetDetachedRendering(bool detached) override;
+		void MakeContextCurrent(bool current) override;
 
 	  private:
-		void DrawRect(const Rect& rect, const Color& color);
-		void DrawLine(float x1, float y1, float x2, float y2, const Color& color);
-		void DrawText(const std::string& text, float x, float y, const Color& color);
-		void ClearScreen(const Color& color);
+		// Uploads batcher_'s output and draws it inside damage
+		void SubmitPartial(DamageRegion& damage);
 
 		int width_;
 		int height_;
 		bool initialized_;
+		EventQueue* eventQueue_;
 		void* window_;	 // GLFW window handle
 		bool ownsWindow_; // Whether this backend created the window
+		bool detached_; // drawing runs on a render thread
+		GeometryBatcher batcher_;
+		GLBatchSubmitter submitter_;
+		DamageHistory damageHistory_;
+		GlyphCache glyphCache_;
 	};
 
 } // namespace SnowUI
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "SnowUI/Render/IRenderBackend.h"
+#include "SnowUI/Render/BlendKernels.h"
+#include "SnowUI/Render/GlyphCache.h"
+#include "SnowUI/Core/ThreadPool.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace SnowUI
+{
+
+	// SoftwareBackend rasterizes a DrawList on the CPU into an RGBA8 framebuffer.
+	// It needs no window or GPU, which makes it the backend of choice for
+	// headless render nodes. Each frame the commands are binned into fixed-size
+	// screen tiles, and the tiles are then rasterized in parallel on a thread
+	// pool; every tile replays only the primitives that touch it, in order.
+	// The framebuffer persists between frames, so partial redraws only visit
+	// the tiles under the damage and clip to it.
+	class SoftwareBackend : public IRenderBackend
+	{
+	  public:
+		static constexpr int kTileSize = 64;
+
+		// threadCount <= 0 uses every hardware thread
+		explicit SoftwareBackend(int threadCount = 0);
+		virtual ~SoftwareBackend();
+
+		bool Initialize(int width, int height) override;
+		void Shutdown() override;
+		void BeginFrame() override;
+		void EndFrame() override;
+		void ExecuteDrawList(const DrawList& drawList) override;
+		void ExecuteDrawListPartial(const DrawList& drawList, DamageRegion& damage) override;
+		void ExecuteDrawChainPartial(const DrawChain& chain, DamageRegion& damage) override;
+		void Resize(int width, int height) override;
+		GlyphCache* GetGlyphCache() override
+		{
+			return &glyphCache_;
+		}
+
+		int GetWidth() const
+		{
+			return width_;
+		}
+		int GetHeight() const
+		{
+			return height_;
+		}
+
+		// Premultiplied RGBA8 pixels, row-major, top row first. Byte order in
+		// memory is R, G, B, A regardless of host endianness.
+		const uint8_t* GetPixels() const
+		{
+			return reinterpret_cast<const uint8_t*>(framebuffer_.data());
+		}
+
+		// Copies the framebuffer as tightly packed RGBA8 rows, top row first
+		bool ReadPixels(std::vector<uint8_t>& pixels) const;
+
+		// Overrides the runtime-selected blend kernels, e.g. to compare ISAs
+		void SetBlendISA(BlendISA isa)
+		{
+			kernels_ = &GetBlendKernels(isa);
+		}
+		BlendISA GetBlendISA() const
+		{
+			return kernels_->isa;
+		}
+
+	  private:
+		enum class PrimitiveType : uint8_t
+		{
+			Fill,  // opaque overwrite (Clear)
+			Blend, // source-over rect
+			Line,
+			Glyph, // coverage-masked blend from the glyph atlas
+		};
+
+		struct Primitive
+		{
+			PrimitiveType type;
+			uint32_t color; // premultiplied RGBA8
+			uint8_t alpha;
+			int x0, y0, x1, y1; // pixel bounds, exclusive max
+			float lx0, ly0, lx1, ly1; // line end points
+			int srcX, srcY;           // glyph atlas texel at (x0, y0), before clipping
+		};
+
+		// Converts commands to primitives; call BeginPrimitives() first
+		void BeginPrimitives();
+		void BuildPrimitives(const DrawList& drawList);
+		// Clips to damage, or to everything after a resize; false if nothing
+		// needs drawing
+		bool SetClipRects(DamageRegion& damage);
+		void AddRect(float x0, float y0, float x1, float y1, const Color& color, PrimitiveType type);
+		void AddLine(float x1, float y1, float x2, float y2, const Color& color);
+		void AddGlyph(const GlyphQuad& quad, const Color& color);
+		void BinPrimitives();
+		void Rasterize();
+		void RasterizeTile(size_t tileIndex);
+		void FillRect(const Primitive& prim, int x0, int y0, int x1, int y1);
+		void DrawLineClipped(const Primitive& prim, int x0, int y0, int x1, int y1);
+		void DrawGlyph(const Primitive& prim, int x0, int y0, int x1, int y1);
+
+		int width_;
+		int height_;
+		bool initialized_;
+		int threadCount_;
+		std::unique_ptr<ThreadPool> pool_;
+		const BlendKernels* kernels_;
+		GlyphCache glyphCache_;
+
+		std::vector<uint32_t> framebuffer_;
+		std::vector<Primitive> primitives_;
+		int tilesX_;
+		int tilesY_;
+		std::vector<std::vector<uint32_t>> tileBins_;
+		std::vector<DamageRect> clipRects_; // disjoint regions redrawn this frame
+		bool fullRedrawPending_;            // framebuffer content is not from a previous frame
+	};
+
+} // namespace SnowUI
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "DrawCommand.h"
+#include "Font.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace SnowUI
+{
+
+	// Extents of a single line of text
+	struct TextMetrics
+	{
+		float width;
+		float height; // line height of the font
+		float ascent;
+	};
+
+	enum class TextAlign : uint8_t
+	{
+		Start,
+		Center,
+		End,
+	};
+
+	// Where to record a line of text so that it is aligned inside a rect
+	struct TextLayout
+	{
+		float x, y; // top-left, as expected by DrawList::AddText
+		TextMetrics metrics;
+	};
+
+	struct TextMeasureStats
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		size_t entryCount = 0;
+	};
+
+	// Process-wide cache of text measurements keyed by (string hash, font, size).
+	//
+	// The first query for a string walks its codepoints and sums advances from
+	// FontRegistry; later queries are a single hash lookup. The stored string
+	// is compared on lookup, so hash collisions never return wrong extents.
+	// Everything is dropped when the font registry generation changes, and
+	// when the cache grows past its entry limit. Thread-safe: the entries are
+	// split into shards by string hash, each behind its own mutex, so parallel
+	// paint threads measuring different strings rarely wait on each other.
+	class TextMeasureCache
+	{
+	  public:
+		static TextMeasureCache& Instance();
+
+		TextMetrics Measure(std::string_view text, FontId font, uint16_t size);
+
+		// Maximum number of cached strings. Each shard holds an equal part of it
+		// and is flushed on its own when full.
+		void SetCapacity(size_t capacity);
+
+		TextMeasureStats GetStats() const;
+		void Clear();
+
+	  private:
+		TextMeasureCache();
+
+		struct Key
+		{
+			uint64_t hash;
+			FontId font;
+			uint16_t size;
+
+			bool operator==(const Key& other) const
+			{
+				return hash == other.hash && font == other.font && size == other.size;
+			}
+		};
+
+		struct KeyHash
+		{
+			size_t operator()(const Key& key) const
+			{
+				const uint64_t style = (static_cast<uint64_t>(key.font) << 16) | key.size;
+				return static_cast<size_t>(key.hash ^ (style * 0x9E3779B97F4A7C15ull));
+			}
+		};
+
+		struct Entry
+		{
+			std::string text;
+			TextMetrics metrics;
+		};
+
+		// Advances of printable ASCII for one (font, size), filled on first use
+		struct AsciiAdvances
+		{
+			FontMetrics metrics;
+			std::array<float, 128> advance;
+		};
+
+		// One independently locked part of the cache. Each shard keeps its own
+		// ASCII advance tables, so a miss never touches another shard.
+		struct alignas(64) Shard
+		{
+			mutable std::mutex mutex;
+			std::unordered_multimap<Key, Entry, KeyHash> entries;
+			std::unordered_map<uint32_t, AsciiAdvances> asciiAdvances; // key: font << 16 | size
+			uint32_t fontGeneration = 0;
+			uint64_t hits = 0;
+			uint64_t misses = 0;
+		};
+
+		static constexpr size_t kShardCount = 64;
+
+		static void CheckGeneration(Shard& shard);
+		static const AsciiAdvances& GetAsciiAdvances(Shard& shard, FontId font, uint16_t size);
+		static TextMetrics Compute(Shard& shard, std::string_view text, FontId font, uint16_t size);
+
+		std::array<Shard, kShardCount> shards_;
+		std::atomic<size_t> shardCapacity_;
+	};
+
+	inline TextMetrics MeasureText(std::string_view text, FontId font = kDefaultFont,
+	                               uint16_t size = kDefaultFontSize)
+	{
+		return TextMeasureCache::Instance().Measure(text, font, size);
+	}
+
+	// Aligns one line of text inside bounds. Vertical alignment uses the line
+	// height, so text of the same font sits on the same baseline regardless of
+	// its content.
+	TextLayout LayoutText(std::string_view text, const Rect& bounds, TextAlign horizontal, TextAlign vertical,
+	                      FontId font = kDefaultFont, uint16_t size = kDefaultFontSize);
+
+} // namespace SnowUI
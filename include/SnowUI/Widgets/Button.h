@@ -12,15 +12,25 @@ namespace SnowUI
 		virtual ~Button() = default;
 
 		void OnPaint(DrawList& drawList) override;
+		Size OnMeasure() override;
+		bool IsPaintThreadSafe() const override
+		{
+			return true;
+		}
 		void OnEvent(const Event& event) override;
 
-		void SetOnClick(void (*callback)())
+		// Emitted when a press is released over the button
+		Signal<>& GetClickSignal()
 		{
-			onClick_ = callback;
+			return click_;
 		}
+		// Sets the one callback SetOnClick() manages, replacing the previous
+		// one; other slots of the click signal stay connected
+		void SetOnClick(Delegate<void()> callback);
 
 	  private:
-		void (*onClick_)();
+		Signal<> click_;
+		ConnectionId onClick_;
 		bool isPressed_;
 	};
 
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "../Core/Widget.h"
+#include "IDataSource.h"
+#include "ScrollBar.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SnowUI
+{
+
+	struct DataGridCacheStats
+	{
+		uint64_t hits = 0;	 // rows drawn from cached text
+		uint64_t misses = 0; // rows formatted by the data source
+	};
+
+	// Table view over an IDataSource.
+	//
+	// Rows are virtualized like PropertyGrid's: only the rows on screen are
+	// recorded, and the row at a point follows from the scroll offset. Their
+	// cell text is formatted through the source once and kept in a small
+	// cache indexed by row modulo its size, which holds a couple of screens
+	// of rows, so scrolling by a few rows reformats only the rows that came
+	// into view.
+	class DataGrid : public Widget
+	{
+	  public:
+		static constexpr float kRowHeight = 22.0f;
+		static constexpr float kHeaderHeight = 24.0f;
+		// Rows AutoSizeColumns() measures per column
+		static constexpr size_t kSampleRows = 256;
+		static constexpr size_t kNoRow = ~static_cast<size_t>(0);
+
+		DataGrid();
+		virtual ~DataGrid() = default;
+
+		void OnPaint(DrawList& drawList) override;
+		void OnEvent(const Event& event) override;
+		void SetBounds(const Rect& bounds) override;
+
+		// The source is not owned and must outlive the grid or be replaced
+		// first. Columns are sized by AutoSizeColumns().
+		void SetDataSource(IDataSource* source);
+		IDataSource* GetDataSource() const
+		{
+			return source_;
+		}
+
+		// Re-reads the row count and drops all cached text, after the
+		// source's data changed wholesale
+		void Refresh();
+		// Drops cached text of rows [first, first + count) and repaints the
+		// ones on screen
+		void InvalidateRows(size_t first, size_t count);
+
+		// Fits each column to its header and to kSampleRows rows spread
+		// evenly over the table, instead of measuring every row
+		void AutoSizeColumns();
+		void SetColumnWidth(size_t column, float width);
+		float GetColumnWidth(size_t column) const
+		{
+			return column < columnWidths_.size() ? columnWidths_[column] : 0.0f;
+		}
+
+		void SetScrollOffset(double offset);
+		double GetScrollOffset() const
+		{
+			return scroll_.GetOffset();
+		}
+		double GetMaxScrollOffset() const
+		{
+			return scroll_.GetMaxOffset();
+		}
+		// Scrolls the minimum distance that brings a row fully into view
+		void EnsureVisible(size_t row);
+
+		// Row at a point in the body of the grid, or kNoRow
+		size_t GetRowAt(float x, float y) const;
+
+		size_t GetSelectedRow() const
+		{
+			return selectedRow_;
+		}
+		void SetSelectedRow(size_t row);
+
+		const DataGridCacheStats& GetCacheStats() const
+		{
+			return cacheStats_;
+		}
+
+	  private:
+		struct Cell
+		{
+			std::string text;
+			float width;
+		};
+
+		struct CachedRow
+		{
+			size_t row = kNoRow;
+			std::vector<Cell> cells;
+		};
+
+		// Cell text of a row, formatting it if it is not cached
+		const std::vector<Cell>& GetRowCells(size_t row);
+		void ResizeCache();
+		void ClearCache();
+
+		// Area below the header that rows scroll in
+		Rect GetBodyRect() const;
+		// Rows overlapping the body, as [first, last)
+		void GetVisibleRange(size_t& first, size_t& last) const;
+		float GetRowTop(size_t row) const;
+		void UpdateScrollRange();
+
+		IDataSource* source_;
+		size_t rowCount_;
+		std::vector<std::string> columnNames_;
+		std::vector<float> columnWidths_;
+		std::vector<CachedRow> cache_;
+		DataGridCacheStats cacheStats_;
+		std::string scratch_;
+		size_t selectedRow_;
+		ScrollBar scroll_;
+	};
+
+} // namespace SnowUI
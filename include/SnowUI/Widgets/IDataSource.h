@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace SnowUI
+{
+
+	// Table data that a DataGrid reads on demand. The grid asks only for the
+	// cells it is about to draw or measure, so a source can front millions of
+	// rows without materializing them.
+	class IDataSource
+	{
+	  public:
+		virtual ~IDataSource() = default;
+
+		virtual size_t GetRowCount() const = 0;
+		virtual size_t GetColumnCount() const = 0;
+		virtual std::string GetColumnName(size_t column) const = 0;
+
+		// Writes the display text of a cell into out, reusing its capacity
+		virtual void FormatCell(size_t row, size_t column, std::string& out) const = 0;
+	};
+
+} // namespace SnowUI
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SnowUI
+{
+
+	// Provider-defined identifier of a tree item
+	using TreeItemKey = uint64_t;
+
+	// Hierarchy that a TreeView loads on demand. Children are requested
+	// the first time their parent is expanded, and labels only for the
+	// items on screen.
+	class ITreeProvider
+	{
+	  public:
+		virtual ~ITreeProvider() = default;
+
+		virtual void GetRootItems(std::vector<TreeItemKey>& out) const = 0;
+		virtual void GetChildren(TreeItemKey parent, std::vector<TreeItemKey>& out) const = 0;
+		// Whether to draw an expander, answered without listing the children
+		virtual bool HasChildren(TreeItemKey item) const = 0;
+
+		// Writes the display text of an item into out, reusing its capacity
+		virtual void FormatLabel(TreeItemKey item, std::string& out) const = 0;
+	};
+
+} // namespace SnowUI
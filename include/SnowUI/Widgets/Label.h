@@ -12,6 +12,11 @@ namespace SnowUI
 		virtual ~Label() = default;
 
 		void OnPaint(DrawList& drawList) override;
+		Size OnMeasure() override;
+		bool IsPaintThreadSafe() const override
+		{
+			return true;
+		}
 	};
 
 } // namespace SnowUI
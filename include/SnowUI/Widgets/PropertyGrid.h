@@ -1,34 +1,240 @@
 #pragma once
 
 #include "../Core/Widget.h"
+#include "../Core/TrigramIndex.h"
+#include "ScrollBar.h"
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace SnowUI
 {
 
-	struct PropertyItem
+	enum class PropertyType : uint8_t
 	{
-		std::string name;
-		std::string value;
-		std::string type;
+		String,
+		Int,
+		Float,
+		Bool,
+		Color, // packed 0xRRGGBBAA
 	};
 
+	// A property value held in its native type; only strings own memory
+	struct PropertyValue
+	{
+		PropertyType type;
+		union
+		{
+			int64_t intValue;
+			double floatValue;
+			bool boolValue;
+			uint32_t colorValue;
+		};
+		std::string stringValue;
+
+		PropertyValue() : type(PropertyType::String), intValue(0)
+		{
+		}
+
+		static PropertyValue String(std::string value)
+		{
+			PropertyValue v;
+			v.stringValue = std::move(value);
+			return v;
+		}
+		static PropertyValue Int(int64_t value)
+		{
+			PropertyValue v;
+			v.type = PropertyType::Int;
+			v.intValue = value;
+			return v;
+		}
+		static PropertyValue Float(double value)
+		{
+			PropertyValue v;
+			v.type = PropertyType::Float;
+			v.floatValue = value;
+			return v;
+		}
+		static PropertyValue Bool(bool value)
+		{
+			PropertyValue v;
+			v.type = PropertyType::Bool;
+			v.boolValue = value;
+			return v;
+		}
+		static PropertyValue FromColor(uint32_t rgba)
+		{
+			PropertyValue v;
+			v.type = PropertyType::Color;
+			v.colorValue = rgba;
+			return v;
+		}
+
+		bool operator==(const PropertyValue& other) const;
+		bool operator!=(const PropertyValue& other) const
+		{
+			return !(*this == other);
+		}
+
+		// Display text, e.g. "42", "0.5", "true" or "#202020FF"
+		void Format(std::string& out) const;
+	};
+
+	// Index of a property in its grid, in insertion order
+	using PropertyId = uint32_t;
+	static constexpr PropertyId kNoProperty = ~0u;
+
+	struct PropertyUpdate
+	{
+		PropertyId id;
+		PropertyValue value;
+	};
+
+	// Scrolling list of name/value rows.
+	//
+	// Rows have a fixed height, so the rows on screen and the row under the
+	// cursor follow directly from the scroll offset. Painting records only
+	// the visible rows, which keeps a frame's cost independent of how many
+	// properties the grid holds.
+	//
+	// Values are stored typed and formatted only when a row is painted; the
+	// text is cached until the value changes. Names are interned, so grids
+	// with many rows sharing a name store it once.
+	//
+	// SetFilter() shows only the properties whose name contains a string.
+	// Names are kept in a TrigramIndex, so filtering costs time in the number
+	// of matches rather than the number of properties. "Row" below means a
+	// row as displayed, i.e. a position in the filtered list.
 	class PropertyGrid : public Widget
 	{
 	  public:
+		static constexpr float kRowHeight = 25.0f;
+
 		PropertyGrid();
 		virtual ~PropertyGrid() = default;
 
 		void OnPaint(DrawList& drawList) override;
 		void OnEvent(const Event& event) override;
+		void SetBounds(const Rect& bounds) override;
 
-		void AddProperty(const std::string& name, const std::string& value, const std::string& type = "string");
+		PropertyId AddProperty(std::string_view name, PropertyValue value);
+		void Reserve(size_t count);
 		void Clear();
 
+		size_t GetPropertyCount() const
+		{
+			return rows_.size();
+		}
+		std::string_view GetPropertyName(PropertyId id) const
+		{
+			return names_[rows_[id].nameId];
+		}
+		const PropertyValue& GetValue(PropertyId id) const
+		{
+			return rows_[id].value;
+		}
+
+		// Changes one value; repaints its row only if it is on screen
+		void SetValue(PropertyId id, const PropertyValue& value);
+		// Applies a batch of changes, skipping unchanged values. Only the
+		// visible rows among the changed ones are damaged.
+		void SetValues(const PropertyUpdate* updates, size_t count);
+		void SetValues(const std::vector<PropertyUpdate>& updates)
+		{
+			SetValues(updates.data(), updates.size());
+		}
+
+		// Emitted by SetValue()/SetValues() for each value that changed. One
+		// signal serves every property, so thousands of them cost nothing
+		// until something connects.
+		Signal<PropertyId, const PropertyValue&>& GetValueChangedSignal()
+		{
+			return valueChanged_;
+		}
+
+		// Pixels scrolled from the top, clamped to the scrollable range
+		void SetScrollOffset(double offset);
+		double GetScrollOffset() const
+		{
+			return scroll_.GetOffset();
+		}
+		double GetMaxScrollOffset() const
+		{
+			return scroll_.GetMaxOffset();
+		}
+
+		// Shows only properties whose name contains text, ignoring ASCII
+		// case. An empty string shows everything.
+		void SetFilter(std::string_view text);
+		const std::string& GetFilter() const
+		{
+			return filter_;
+		}
+
+		// Number of rows shown, and the property displayed in each
+		size_t GetRowCount() const
+		{
+			return filterActive_ ? filteredRows_.size() : rows_.size();
+		}
+		PropertyId GetRowProperty(size_t row) const
+		{
+			return filterActive_ ? filteredRows_[row] : static_cast<PropertyId>(row);
+		}
+		// Row showing a property; false if the filter hides it
+		bool FindRow(PropertyId id, size_t& row) const;
+
+		PropertyId GetSelectedProperty() const
+		{
+			return selectedId_;
+		}
+
+		// Scrolls the minimum distance that brings a row fully into view
+		void EnsureVisible(size_t row);
+
+		// Row at a point inside the grid, or -1
+		int GetRowAt(float x, float y) const;
+
 	  private:
-		std::vector<PropertyItem> items_;
-		int selectedIndex_;
+		struct Row
+		{
+			uint32_t nameId;
+			bool formatValid; // formatted matches value
+			PropertyValue value;
+			std::string formatted;
+		};
+
+		uint32_t InternName(std::string_view name);
+		// Stores a value and reports whether it changed
+		bool StoreValue(PropertyId id, const PropertyValue& value);
+		// Damages the row showing id if it is on screen
+		void InvalidateProperty(PropertyId id, size_t first, size_t last);
+		// Rows overlapping the viewport, as [first, last)
+		void GetVisibleRange(size_t& first, size_t& last) const;
+		// Screen y of a row's top edge, and its rect cut to the grid
+		float GetRowTop(size_t row) const;
+		Rect GetRowRect(size_t row) const;
+
+		// X offset of the value column from the left edge of the grid
+		float GetValueColumnOffset() const;
+		// Tells scroll_ about a new row count
+		void UpdateScrollRange();
+
+		std::vector<Row> rows_;
+		Signal<PropertyId, const PropertyValue&> valueChanged_;
+		std::deque<std::string> names_; // deque keeps the map's views valid
+		std::unordered_map<std::string_view, uint32_t> nameIds_;
+		TrigramIndex nameIndex_; // by PropertyId
+		std::string filter_;
+		bool filterActive_;
+		std::vector<PropertyId> filteredRows_; // ascending
+		std::vector<PropertyId> filterScratch_;
+		PropertyId selectedId_;
+		float maxNameWidth_; // widest name seen since the last Clear()
+		ScrollBar scroll_;
 	};
 
 } // namespace SnowUI
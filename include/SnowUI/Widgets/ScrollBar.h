@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../Core/Event.h"
+#include "../Render/DrawCommand.h"
+
+namespace SnowUI
+{
+
+	// Vertical scroll state for widgets that scroll their own content: the
+	// offset, the bar's geometry, and wheel and thumb-drag handling. The owner
+	// keeps the viewport and content height current and repaints whenever a
+	// call reports a change.
+	class ScrollBar
+	{
+	  public:
+		static constexpr float kWidth = 8.0f;
+
+		// Screen area the content scrolls in; the bar runs down its right edge
+		void SetViewport(const Rect& viewport);
+		const Rect& GetViewport() const
+		{
+			return viewport_;
+		}
+		void SetContentHeight(double height);
+
+		// Pixels scrolled from the top. The setter clamps to the scrollable
+		// range and returns true if the offset changed. Offsets are doubles
+		// because long lists outgrow the integers a float holds exactly.
+		bool SetOffset(double offset);
+		double GetOffset() const
+		{
+			return offset_;
+		}
+		double GetMaxOffset() const;
+
+		// True when the content is taller than the viewport
+		bool IsShown() const
+		{
+			return contentHeight_ > viewport_.height;
+		}
+
+		// Scrolls the minimum distance that brings [top, bottom) of the
+		// content into view
+		bool ScrollIntoView(double top, double bottom);
+
+		// Handles wheel events anywhere in the viewport and clicks and drags
+		// on the bar. Returns true if the event was consumed; changed is set
+		// when the offset or the bar's appearance changed.
+		bool HandleEvent(const Event& event, double wheelStep, bool& changed);
+
+		void Paint(DrawList& drawList) const;
+
+	  private:
+		Rect GetThumb() const;
+
+		Rect viewport_;
+		double contentHeight_ = 0.0;
+		double offset_ = 0.0;
+		bool dragging_ = false;
+		float dragStartY_ = 0.0f;
+		double dragStartOffset_ = 0.0;
+	};
+
+} // namespace SnowUI
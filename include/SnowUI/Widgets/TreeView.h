@@ -0,0 +1,138 @@
+#pragma once
+
+#include "../Core/Widget.h"
+#include "ITreeProvider.h"
+#include "ScrollBar.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SnowUI
+{
+
+	// Scrolling tree over an ITreeProvider.
+	//
+	// Loaded items are plain records in one array; the children of an item
+	// are appended together the first time it is expanded, and kept when it
+	// is collapsed, so re-expanding does not ask the provider again. The rows
+	// on screen come from a flat array of the visible items in display order:
+	// expanding splices the newly visible items in after their parent and
+	// collapsing removes them, so painting and hit testing only ever touch
+	// the rows in view.
+	class TreeView : public Widget
+	{
+	  public:
+		static constexpr float kRowHeight = 20.0f;
+		static constexpr float kIndent = 16.0f;
+		static constexpr size_t kNoRow = ~static_cast<size_t>(0);
+
+		TreeView();
+		virtual ~TreeView() = default;
+
+		void OnPaint(DrawList& drawList) override;
+		void OnEvent(const Event& event) override;
+		void SetBounds(const Rect& bounds) override;
+
+		// The provider is not owned and must outlive the view or be replaced
+		// first. Loads the root items.
+		void SetProvider(ITreeProvider* provider);
+		ITreeProvider* GetProvider() const
+		{
+			return provider_;
+		}
+		// Forgets every loaded item and reloads the roots
+		void Refresh();
+
+		// Rows are the visible items in display order
+		size_t GetRowCount() const
+		{
+			return rows_.size();
+		}
+		TreeItemKey GetRowItem(size_t row) const
+		{
+			return nodes_[rows_[row]].key;
+		}
+		uint32_t GetRowDepth(size_t row) const
+		{
+			return nodes_[rows_[row]].depth;
+		}
+		bool IsRowExpanded(size_t row) const
+		{
+			return nodes_[rows_[row]].expanded;
+		}
+
+		void ExpandRow(size_t row);
+		void CollapseRow(size_t row);
+		void ToggleRow(size_t row);
+
+		// Items loaded from the provider so far
+		size_t GetLoadedCount() const
+		{
+			return nodes_.size();
+		}
+
+		// False if nothing is selected
+		bool GetSelectedItem(TreeItemKey& item) const;
+		void SetSelectedRow(size_t row);
+
+		void SetScrollOffset(double offset);
+		double GetScrollOffset() const
+		{
+			return scroll_.GetOffset();
+		}
+		double GetMaxScrollOffset() const
+		{
+			return scroll_.GetMaxOffset();
+		}
+		// Scrolls the minimum distance that brings a row fully into view
+		void EnsureVisible(size_t row);
+
+		// Row at a point inside the view, or kNoRow
+		size_t GetRowAt(float x, float y) const;
+
+	  private:
+		static constexpr uint32_t kNoNode = ~0u;
+
+		struct Node
+		{
+			TreeItemKey key;
+			uint32_t parent;
+			uint32_t firstChild; // children are contiguous in nodes_
+			uint32_t childCount;
+			uint32_t depth;
+			bool hasChildren;
+			bool childrenLoaded;
+			bool expanded;
+		};
+
+		struct CachedLabel
+		{
+			uint32_t node = kNoNode;
+			std::string text;
+		};
+
+		// Appends items as children of parent (kNoNode for roots)
+		void AppendNodes(const std::vector<TreeItemKey>& keys, uint32_t parent, uint32_t depth);
+		void LoadChildren(uint32_t node);
+		// Visible descendants of an expanded node, in display order
+		void CollectVisible(uint32_t node, std::vector<uint32_t>& out) const;
+		const std::string& GetLabel(uint32_t node);
+		void ResizeLabelCache();
+
+		float GetRowTop(size_t row) const;
+		void GetVisibleRange(size_t& first, size_t& last) const;
+		// Left edge of the expander box of a row
+		float GetExpanderX(size_t row) const;
+		void UpdateScrollRange();
+
+		ITreeProvider* provider_;
+		std::vector<Node> nodes_;
+		std::vector<uint32_t> rows_; // node of each visible row
+		std::vector<CachedLabel> labels_;
+		std::vector<TreeItemKey> keyScratch_;
+		std::vector<uint32_t> rowScratch_;
+		uint32_t selectedNode_;
+		ScrollBar scroll_;
+	};
+
+} // namespace SnowUI
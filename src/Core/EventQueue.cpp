@@ -0,0 +1,84 @@
+#include "SnowUI/Core/EventQueue.h"
+#include <algorithm>
+
+namespace SnowUI
+{
+
+	void EventQueue::Push(const Event& event)
+	{
+		Event queued = event;
+		if (queued.timestamp == 0)
+			queued.timestamp = GetEventTimestamp();
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_.pushed++;
+
+		if (!events_.empty() && events_.back().type == queued.type)
+		{
+			Event& last = events_.back();
+			switch (queued.type)
+			{
+			case EventType::MouseMove:
+				last.x = queued.x;
+				last.y = queued.y;
+				stats_.coalesced++;
+				return;
+			case EventType::Resize:
+				last.width = queued.width;
+				last.height = queued.height;
+				stats_.coalesced++;
+				return;
+			case EventType::MouseWheel:
+				if (last.x == queued.x && last.y == queued.y)
+				{
+					last.wheelX += queued.wheelX;
+					last.wheelY += queued.wheelY;
+					stats_.coalesced++;
+					return;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		events_.push_back(queued);
+	}
+
+	void EventQueue::Drain(std::vector<Event>& batch)
+	{
+		batch.clear();
+		std::lock_guard<std::mutex> lock(mutex_);
+		batch.swap(events_);
+		stats_.lastBatchSize = batch.size();
+	}
+
+	bool EventQueue::IsEmpty() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return events_.empty();
+	}
+
+	void EventQueue::RecordDelivery(const Event& event, uint64_t now)
+	{
+		const uint64_t latency = now > event.timestamp ? now - event.timestamp : 0;
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_.delivered++;
+		stats_.totalLatencyUs += latency;
+		stats_.maxLatencyUs = std::max(stats_.maxLatencyUs, latency);
+		stats_.latency.Add(latency);
+	}
+
+	EventQueueStats EventQueue::GetStats() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return stats_;
+	}
+
+	void EventQueue::ResetStats()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_ = EventQueueStats();
+	}
+
+} // namespace SnowUI
@@ -0,0 +1,163 @@
+#include "SnowUI/Core/HitTestGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SnowUI
+{
+
+	static bool Contains(const Rect& rect, float x, float y)
+	{
+		return x >= rect.x && x <= rect.x + rect.width && y >= rect.y && y <= rect.y + rect.height;
+	}
+
+	void HitTestGrid::Rebuild(const WidgetStore& store, int width, int height)
+	{
+		cellsX_ = std::max(1, (width + kCellSize - 1) / kCellSize);
+		cellsY_ = std::max(1, (height + kCellSize - 1) / kCellSize);
+		cells_.assign(static_cast<size_t>(cellsX_) * static_cast<size_t>(cellsY_), std::vector<WidgetSlot>());
+		large_.clear();
+		widgetCount_ = 0;
+
+		// Forget the old cell ranges; they refer to the previous layout
+		slotCells_.clear();
+		Insert(store, 1, static_cast<WidgetSlot>(store.GetCount()));
+	}
+
+	HitTestCells HitTestGrid::GetCellRange(const Rect& bounds) const
+	{
+		// Anything off the surface is clamped into the border cells, so points
+		// on the surface still find it
+		auto cellX = [this](float x) {
+			return std::min(std::max(static_cast<int>(std::floor(x / kCellSize)), 0), cellsX_ - 1);
+		};
+		auto cellY = [this](float y) {
+			return std::min(std::max(static_cast<int>(std::floor(y / kCellSize)), 0), cellsY_ - 1);
+		};
+
+		HitTestCells range;
+		range.x0 = cellX(bounds.x);
+		range.y0 = cellY(bounds.y);
+		range.x1 = cellX(bounds.x + bounds.width);
+		range.y1 = cellY(bounds.y + bounds.height);
+		range.large = (range.x1 - range.x0 + 1) * (range.y1 - range.y0 + 1) > kMaxCellsPerWidget;
+		return range;
+	}
+
+	void HitTestGrid::EraseFrom(std::vector<WidgetSlot>& list, WidgetSlot slot)
+	{
+		auto it = std::find(list.begin(), list.end(), slot);
+		if (it != list.end())
+		{
+			*it = list.back();
+			list.pop_back();
+		}
+	}
+
+	void HitTestGrid::AddToCells(WidgetSlot slot, const HitTestCells& range)
+	{
+		if (range.large)
+		{
+			large_.push_back(slot);
+			return;
+		}
+		for (int y = range.y0; y <= range.y1; ++y)
+		{
+			for (int x = range.x0; x <= range.x1; ++x)
+			{
+				cells_[static_cast<size_t>(y) * cellsX_ + x].push_back(slot);
+			}
+		}
+	}
+
+	void HitTestGrid::RemoveFromCells(WidgetSlot slot, const HitTestCells& range)
+	{
+		if (range.large)
+		{
+			EraseFrom(large_, slot);
+			return;
+		}
+		for (int y = range.y0; y <= range.y1; ++y)
+		{
+			for (int x = range.x0; x <= range.x1; ++x)
+			{
+				EraseFrom(cells_[static_cast<size_t>(y) * cellsX_ + x], slot);
+			}
+		}
+	}
+
+	void HitTestGrid::Insert(const WidgetStore& store, WidgetSlot first, WidgetSlot last)
+	{
+		if (cells_.empty())
+			return;
+		if (slotCells_.size() < last)
+			slotCells_.resize(last);
+
+		for (WidgetSlot slot = first; slot < last; ++slot)
+		{
+			if (slotCells_[slot].indexed)
+				continue;
+
+			HitTestCells range = GetCellRange(store.GetBounds(slot));
+			range.indexed = true;
+			AddToCells(slot, range);
+			slotCells_[slot] = range;
+			widgetCount_++;
+		}
+	}
+
+	void HitTestGrid::Remove(WidgetSlot slot)
+	{
+		if (slot >= slotCells_.size() || !slotCells_[slot].indexed)
+			return;
+
+		RemoveFromCells(slot, slotCells_[slot]);
+		slotCells_[slot] = HitTestCells();
+		widgetCount_--;
+	}
+
+	void HitTestGrid::Update(const WidgetStore& store, WidgetSlot slot)
+	{
+		if (slot >= slotCells_.size() || !slotCells_[slot].indexed)
+			return;
+
+		HitTestCells range = GetCellRange(store.GetBounds(slot));
+		range.indexed = true;
+		const HitTestCells& old = slotCells_[slot];
+		if (range.x0 == old.x0 && range.y0 == old.y0 && range.x1 == old.x1 && range.y1 == old.y1)
+			return;
+
+		RemoveFromCells(slot, old);
+		AddToCells(slot, range);
+		slotCells_[slot] = range;
+	}
+
+	WidgetSlot HitTestGrid::HitTest(const WidgetStore& store, float x, float y) const
+	{
+		if (cells_.empty())
+			return kNoWidgetSlot;
+
+		const int cx = static_cast<int>(std::floor(x / kCellSize));
+		const int cy = static_cast<int>(std::floor(y / kCellSize));
+		if (cx < 0 || cy < 0 || cx >= cellsX_ || cy >= cellsY_)
+			return kNoWidgetSlot;
+
+		WidgetSlot best = kNoWidgetSlot;
+		auto consider = [&](WidgetSlot slot) {
+			if (!Contains(store.GetBounds(slot), x, y) || !store.IsVisibleInTree(slot))
+				return;
+			if (best == kNoWidgetSlot || store.IsPaintedAfter(slot, best))
+				best = slot;
+		};
+
+		for (WidgetSlot slot : cells_[static_cast<size_t>(cy) * cellsX_ + cx])
+		{
+			consider(slot);
+		}
+		for (WidgetSlot slot : large_)
+		{
+			consider(slot);
+		}
+		return best;
+	}
+
+} // namespace SnowUI
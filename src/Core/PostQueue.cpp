@@ -0,0 +1,188 @@
+#include "SnowUI/Core/PostQueue.h"
+#include <thread>
+
+namespace SnowUI
+{
+
+	// Slots probed for a key before it falls back to the backlog's map
+	static constexpr size_t kMaxProbes = 16;
+
+	PostQueue::PostQueue() : head_(nullptr), slots_(new KeySlot[kKeySlots])
+	{
+	}
+
+	PostQueue::~PostQueue()
+	{
+		Node* node = head_.load(std::memory_order_acquire);
+		while (node)
+		{
+			Node* next = node->next;
+			delete node;
+			node = next;
+		}
+		for (size_t i = 0; i < kKeySlots; ++i)
+		{
+			delete slots_[i].pending.load(std::memory_order_acquire);
+		}
+	}
+
+	PostQueue::KeySlot* PostQueue::FindSlot(PostKey key)
+	{
+		// Keys are often addresses; mix the low bits in before masking
+		uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+		hash ^= hash >> 32;
+		for (size_t probe = 0; probe < kMaxProbes; ++probe)
+		{
+			KeySlot& slot = slots_[(hash + probe) & (kKeySlots - 1)];
+			PostKey owner = slot.key.load(std::memory_order_acquire);
+			if (owner != kNoPostKey && owner != key)
+				continue;
+
+			// Becoming a user keeps the UI thread from releasing the slot to
+			// another key before our task is in; releasing takes a few
+			// instructions, so wait it out
+			while (slot.users.fetch_add(1, std::memory_order_acq_rel) & kReleasing)
+			{
+				slot.users.fetch_sub(1, std::memory_order_release);
+				std::this_thread::yield();
+			}
+			owner = slot.key.load(std::memory_order_acquire);
+			if (owner == kNoPostKey &&
+			    slot.key.compare_exchange_strong(owner, key, std::memory_order_acq_rel, std::memory_order_acquire))
+				return &slot;
+			if (owner == key)
+				return &slot;
+			slot.users.fetch_sub(1, std::memory_order_release);
+		}
+		return nullptr;
+	}
+
+	void PostQueue::ReleaseSlot(KeySlot& slot)
+	{
+		// While a push holds the slot it stays claimed; the push normally
+		// queues a newer task for the key, which releases it when it runs
+		uint32_t idle = 0;
+		if (!slot.users.compare_exchange_strong(idle, kReleasing, std::memory_order_acq_rel, std::memory_order_relaxed))
+			return;
+		if (!slot.pending.load(std::memory_order_acquire))
+			slot.key.store(kNoPostKey, std::memory_order_release);
+		slot.users.fetch_sub(kReleasing, std::memory_order_release);
+	}
+
+	bool PostQueue::PushNode(Node* node)
+	{
+		// Once the exchange succeeds the UI thread may take and free node,
+		// so the previous head is kept here rather than read back from it
+		Node* head = head_.load(std::memory_order_relaxed);
+		do
+		{
+			node->next = head;
+		} while (!head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+		return head == nullptr;
+	}
+
+	bool PostQueue::Push(PostKey key, std::function<void()> task)
+	{
+		KeySlot* slot = key != kNoPostKey ? FindSlot(key) : nullptr;
+		if (!slot)
+			return PushNode(new Node{key, std::move(task), nullptr, nullptr});
+
+		// Whoever swaps a task in while the slot is empty queues the slot;
+		// the others replace the waiting task
+		Task* replaced = slot->pending.exchange(new Task(std::move(task)), std::memory_order_acq_rel);
+		slot->users.fetch_sub(1, std::memory_order_release);
+		if (replaced)
+		{
+			delete replaced;
+			slot->replaced.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		return PushNode(new Node{key, Task(), slot, nullptr});
+	}
+
+	void PostQueue::Collect()
+	{
+		Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+		if (!node)
+			return;
+
+		// The stack is newest first
+		collected_.clear();
+		for (; node; node = node->next)
+		{
+			collected_.push_back(node);
+		}
+
+		for (size_t i = collected_.size(); i-- > 0;)
+		{
+			Node* posted = collected_[i];
+			stats_.received++;
+			if (posted->key != kNoPostKey && !posted->slot)
+			{
+				const uint64_t sequence = backlogBase_ + backlog_.size();
+				auto result = latest_.emplace(posted->key, sequence);
+				if (!result.second)
+				{
+					backlog_[result.first->second - backlogBase_].task = std::move(posted->task);
+					stats_.coalesced++;
+					delete posted;
+					continue;
+				}
+			}
+			backlog_.push_back(Entry{posted->key, std::move(posted->task), posted->slot});
+			delete posted;
+		}
+		collected_.clear();
+	}
+
+	bool PostQueue::Run(std::chrono::microseconds budget)
+	{
+		Collect();
+
+		// Tasks posted from here on are collected by the next call
+		const auto deadline = std::chrono::steady_clock::now() + budget;
+		bool first = true;
+		while (!backlog_.empty())
+		{
+			if (!first && std::chrono::steady_clock::now() >= deadline)
+				break;
+
+			Entry entry = std::move(backlog_.front());
+			backlog_.pop_front();
+			backlogBase_++;
+			stats_.run++;
+			first = false;
+
+			if (entry.slot)
+			{
+				// Posts from here on queue the slot again, or claim a slot
+				// anew once it is released
+				std::unique_ptr<Task> task(entry.slot->pending.exchange(nullptr, std::memory_order_acq_rel));
+				ReleaseSlot(*entry.slot);
+				(*task)();
+				continue;
+			}
+
+			if (entry.key != kNoPostKey)
+				latest_.erase(entry.key);
+			entry.task();
+		}
+
+		stats_.backlog = backlog_.size();
+		return !backlog_.empty();
+	}
+
+	PostQueueStats PostQueue::GetStats() const
+	{
+		PostQueueStats stats = stats_;
+		for (size_t i = 0; i < kKeySlots; ++i)
+		{
+			const uint64_t replaced = slots_[i].replaced.load(std::memory_order_relaxed);
+			stats.received += replaced;
+			stats.coalesced += replaced;
+			stats.keySlotsInUse += slots_[i].key.load(std::memory_order_relaxed) != kNoPostKey;
+		}
+		return stats;
+	}
+
+} // namespace SnowUI
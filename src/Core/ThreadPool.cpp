@@ -0,0 +1,204 @@
+#include "SnowUI/Core/ThreadPool.h"
+
+namespace SnowUI
+{
+
+	// Pool and queue index of the worker running on this thread, if any
+	static thread_local const ThreadPool* t_workerPool = nullptr;
+	static thread_local size_t t_workerIndex = 0;
+
+	ThreadPool::ThreadPool(int workerCount)
+		: queuedTasks_(0), stopping_(false), generation_(0), activeWorkers_(0), job_(nullptr), jobCount_(0),
+		  nextIndex_(0)
+	{
+		if (workerCount < 0)
+		{
+			unsigned hw = std::thread::hardware_concurrency();
+			workerCount = hw > 1 ? static_cast<int>(hw) - 1 : 0;
+		}
+
+		// One deque per worker plus one for outside threads
+		for (int i = 0; i <= workerCount; ++i)
+		{
+			queues_.emplace_back(new TaskQueue());
+		}
+
+		workers_.reserve(static_cast<size_t>(workerCount));
+		for (int i = 0; i < workerCount; ++i)
+		{
+			workers_.emplace_back(&ThreadPool::WorkerLoop, this, static_cast<size_t>(i));
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			stopping_ = true;
+		}
+		wake_.notify_all();
+
+		for (auto& worker : workers_)
+		{
+			worker.join();
+		}
+	}
+
+	void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& fn)
+	{
+		if (count == 0)
+			return;
+
+		if (workers_.empty() || count == 1)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				fn(i);
+			}
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			job_ = &fn;
+			jobCount_ = count;
+			nextIndex_.store(0, std::memory_order_relaxed);
+			activeWorkers_ = static_cast<int>(workers_.size());
+			generation_++;
+		}
+		wake_.notify_all();
+
+		RunJob();
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		done_.wait(lock, [this] { return activeWorkers_ == 0; });
+		job_ = nullptr;
+	}
+
+	void ThreadPool::RunJob()
+	{
+		for (;;)
+		{
+			size_t i = nextIndex_.fetch_add(1, std::memory_order_relaxed);
+			if (i >= jobCount_)
+				break;
+			(*job_)(i);
+		}
+	}
+
+	size_t ThreadPool::GetQueueIndex() const
+	{
+		return t_workerPool == this ? t_workerIndex : workers_.size();
+	}
+
+	void ThreadPool::Spawn(TaskGroup& group, std::function<void()> task)
+	{
+		if (workers_.empty())
+		{
+			task();
+			return;
+		}
+
+		group.pending_.fetch_add(1, std::memory_order_relaxed);
+		TaskQueue& queue = *queues_[GetQueueIndex()];
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.tasks.push_back(Task{std::move(task), &group});
+		}
+		queuedTasks_.fetch_add(1, std::memory_order_release);
+
+		// Taking the lock orders the count above before a sleeping worker's
+		// check of it, so the wakeup cannot be missed
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+		}
+		wake_.notify_one();
+	}
+
+	void ThreadPool::Wait(TaskGroup& group)
+	{
+		const size_t index = GetQueueIndex();
+		while (!group.IsDone())
+		{
+			if (!RunOneTask(index))
+				std::this_thread::yield();
+		}
+	}
+
+	bool ThreadPool::RunOneTask(size_t index)
+	{
+		if (queuedTasks_.load(std::memory_order_acquire) == 0)
+			return false;
+
+		Task task;
+		bool found = false;
+		for (size_t i = 0; i < queues_.size() && !found; ++i)
+		{
+			// Own work newest first; others' oldest first
+			const size_t victim = (index + i) % queues_.size();
+			TaskQueue& queue = *queues_[victim];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			if (queue.tasks.empty())
+				continue;
+			if (i == 0)
+			{
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+			}
+			else
+			{
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+			}
+			found = true;
+		}
+		if (!found)
+			return false;
+
+		queuedTasks_.fetch_sub(1, std::memory_order_relaxed);
+		task.fn();
+		task.group->pending_.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	void ThreadPool::WorkerLoop(size_t index)
+	{
+		t_workerPool = this;
+		t_workerIndex = index;
+		uint64_t seenGeneration = 0;
+
+		for (;;)
+		{
+			if (RunOneTask(index))
+				continue;
+
+			bool runJob = false;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				wake_.wait(lock, [&] {
+					return stopping_ || generation_ != seenGeneration ||
+					       queuedTasks_.load(std::memory_order_acquire) > 0;
+				});
+				if (stopping_)
+					return;
+				if (generation_ != seenGeneration)
+				{
+					seenGeneration = generation_;
+					runJob = true;
+				}
+			}
+
+			if (runJob)
+			{
+				RunJob();
+
+				{
+					std::lock_guard<std::mutex> lock(mutex_);
+					activeWorkers_--;
+				}
+				done_.notify_one();
+			}
+		}
+	}
+
+} // namespace SnowUI
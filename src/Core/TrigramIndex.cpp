@@ -0,0 +1,192 @@
+#include "SnowUI/Core/TrigramIndex.h"
+#include <algorithm>
+#include <cstring>
+
+namespace SnowUI
+{
+
+	static char FoldChar(char c)
+	{
+		return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	// Substring test for folded text. Queries are short, so a first-byte
+	// scan plus memcmp beats the general-purpose searches here.
+	static bool Contains(std::string_view text, std::string_view query)
+	{
+		if (query.size() > text.size())
+			return false;
+
+		const char first = query[0];
+		const char* p = text.data();
+		const char* last = text.data() + (text.size() - query.size());
+		for (; p <= last; ++p)
+		{
+			if (*p == first && std::memcmp(p, query.data(), query.size()) == 0)
+				return true;
+		}
+		return false;
+	}
+
+	void TrigramIndex::Fold(std::string_view text, std::string& out)
+	{
+		out.resize(text.size());
+		std::transform(text.begin(), text.end(), out.begin(), FoldChar);
+	}
+
+	bool TrigramIndex::Matches(std::string_view text, std::string_view query)
+	{
+		auto it = std::search(text.begin(), text.end(), query.begin(), query.end(),
+		                      [](char a, char b) { return FoldChar(a) == FoldChar(b); });
+		return it != text.end() || query.empty();
+	}
+
+	uint32_t TrigramIndex::Add(std::string_view text)
+	{
+		const uint32_t id = static_cast<uint32_t>(offsets_.size());
+		const size_t begin = folded_.size();
+		offsets_.push_back(static_cast<uint32_t>(begin));
+		folded_.resize(begin + text.size());
+		std::transform(text.begin(), text.end(), folded_.begin() + begin, FoldChar);
+
+		// Every 1-, 2- and 3-byte sequence is posted once per string
+		scratch_.clear();
+		const char* p = folded_.data() + begin;
+		for (size_t i = 0; i < text.size(); ++i)
+		{
+			for (size_t length = 1; length <= 3 && i + length <= text.size(); ++length)
+			{
+				scratch_.push_back(MakeGram(p + i, length));
+			}
+		}
+		std::sort(scratch_.begin(), scratch_.end());
+		scratch_.erase(std::unique(scratch_.begin(), scratch_.end()), scratch_.end());
+		for (uint32_t gram : scratch_)
+		{
+			postings_[gram].push_back(id);
+		}
+		return id;
+	}
+
+	void TrigramIndex::Clear()
+	{
+		folded_.clear();
+		offsets_.clear();
+		postings_.clear();
+	}
+
+	void TrigramIndex::Reserve(size_t count, size_t textBytes)
+	{
+		offsets_.reserve(count);
+		folded_.reserve(textBytes);
+	}
+
+	// First element of [it, end) not less than id, searching outwards from
+	// it; intersections advance in small steps, which this keeps cache-local
+	static std::vector<uint32_t>::const_iterator Gallop(std::vector<uint32_t>::const_iterator it,
+	                                                    std::vector<uint32_t>::const_iterator end, uint32_t id)
+	{
+		size_t step = 1;
+		const size_t remaining = static_cast<size_t>(end - it);
+		while (step < remaining && it[step] < id)
+		{
+			step *= 2;
+		}
+		return std::lower_bound(it + step / 2, it + std::min(step + 1, remaining), id);
+	}
+
+	const std::vector<uint32_t>* TrigramIndex::GatherPostings(std::string_view folded) const
+	{
+		lists_.clear();
+		const size_t length = std::min<size_t>(folded.size(), 3);
+		for (size_t i = 0; i + length <= folded.size(); ++i)
+		{
+			auto it = postings_.find(MakeGram(folded.data() + i, length));
+			if (it == postings_.end())
+				return nullptr;
+			lists_.push_back(&it->second);
+		}
+		std::sort(lists_.begin(), lists_.end(),
+		          [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+		lists_.erase(std::unique(lists_.begin(), lists_.end()), lists_.end());
+		return lists_.front();
+	}
+
+	void TrigramIndex::Search(std::string_view query, std::vector<uint32_t>& results) const
+	{
+		results.clear();
+		Fold(query, query_);
+		const std::string_view folded(query_);
+		if (folded.empty())
+		{
+			results.resize(offsets_.size());
+			for (uint32_t id = 0; id < results.size(); ++id)
+				results[id] = id;
+			return;
+		}
+		const std::vector<uint32_t>* rarest = GatherPostings(folded);
+		if (!rarest)
+			return;
+
+		// Intersect the posting lists, rarest first, so each pass walks a
+		// shrinking candidate set and gallops through the longer lists
+		results = *rarest;
+		for (size_t i = 1; i < lists_.size() && !results.empty(); ++i)
+		{
+			const std::vector<uint32_t>& list = *lists_[i];
+			auto it = list.begin();
+			size_t kept = 0;
+			for (uint32_t id : results)
+			{
+				it = Gallop(it, list.end(), id);
+				if (it == list.end())
+					break;
+				if (*it == id)
+					results[kept++] = id;
+			}
+			results.resize(kept);
+		}
+
+		// Queries of up to three bytes are a single exact gram; longer ones
+		// can contain all of their trigrams out of sequence
+		if (folded.size() > 3)
+		{
+			size_t kept = 0;
+			for (uint32_t id : results)
+			{
+				if (Contains(GetFolded(id), folded))
+					results[kept++] = id;
+			}
+			results.resize(kept);
+		}
+	}
+
+	void TrigramIndex::Refine(std::string_view query, const std::vector<uint32_t>& candidates,
+	                          std::vector<uint32_t>& results) const
+	{
+		Fold(query, query_);
+		const std::string folded = query_;
+
+		// The query's rarest posting list may well be shorter than the
+		// previous results; any search result is one of them
+		const std::vector<uint32_t>* rarest = GatherPostings(folded);
+		if (!rarest)
+		{
+			results.clear();
+			return;
+		}
+		if (rarest->size() < candidates.size())
+		{
+			Search(folded, results);
+			return;
+		}
+
+		results.clear();
+		for (uint32_t id : candidates)
+		{
+			if (id < offsets_.size() && Contains(GetFolded(id), folded))
+				results.push_back(id);
+		}
+	}
+
+} // namespace SnowUI
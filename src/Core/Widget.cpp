@@ -1,45 +1,360 @@
 #include "SnowUI/Core/Widget.h"
+#include "SnowUI/Layout/Layout.h"
+#include "SnowUI/Core/ThreadPool.h"
+#include "SnowUI/Render/TextLayout.h"
+#include <algorithm>
+#include <typeinfo>
 
 namespace SnowUI
 {
 
-	Widget::Widget() : visible_(true)
+	static bool IsEmptyRect(const Rect& rect)
+	{
+		return rect.width <= 0.0f || rect.height <= 0.0f;
+	}
+
+	static Rect UnionRect(const Rect& a, const Rect& b)
+	{
+		if (IsEmptyRect(a))
+			return b;
+		if (IsEmptyRect(b))
+			return a;
+		const float x0 = std::min(a.x, b.x);
+		const float y0 = std::min(a.y, b.y);
+		const float x1 = std::max(a.x + a.width, b.x + b.width);
+		const float y1 = std::max(a.y + a.height, b.y + b.height);
+		return Rect(x0, y0, x1 - x0, y1 - y0);
+	}
+
+	// Screen extent of commands [first, last) of a list
+	static Rect GetCommandBounds(const DrawList& drawList, size_t first, size_t last)
+	{
+		const auto& commands = drawList.GetCommands();
+		Rect bounds;
+		for (size_t i = first; i < last; ++i)
+		{
+			const DrawCommand& cmd = commands[i];
+			switch (cmd.type)
+			{
+			case DrawCommandType::Clear:
+				// Covers whatever surface it lands on
+				return Rect(-1e6f, -1e6f, 2e6f, 2e6f);
+			case DrawCommandType::DrawRect:
+				bounds = UnionRect(bounds, cmd.rect);
+				break;
+			case DrawCommandType::DrawText:
+			{
+				TextMetrics metrics = MeasureText(drawList.GetText(cmd), cmd.font, cmd.fontSize);
+				bounds = UnionRect(bounds, Rect(cmd.rect.x, cmd.rect.y, metrics.width, metrics.height));
+				break;
+			}
+			case DrawCommandType::DrawLine:
+			{
+				// rect.x, rect.y = start point; rect.width, rect.height = end point
+				const float x0 = std::min(cmd.rect.x, cmd.rect.width);
+				const float y0 = std::min(cmd.rect.y, cmd.rect.height);
+				const float x1 = std::max(cmd.rect.x, cmd.rect.width);
+				const float y1 = std::max(cmd.rect.y, cmd.rect.height);
+				bounds = UnionRect(bounds, Rect(x0, y0, std::max(x1 - x0, 1.0f), std::max(y1 - y0, 1.0f)));
+				break;
+			}
+			}
+		}
+		return bounds;
+	}
+
+	Widget::Widget() : parent_(nullptr), visible_(true), paintDirty_(true), partialPaint_(false), childDirty_(false),
+		  paintThreadSafeTree_(true), siblingIndex_(0), storeSlot_(kNoWidgetSlot), ownerLayout_(nullptr)
 	{
 		bounds_ = Rect(0, 0, 100, 100);
 	}
 
-	void Widget::OnPaint(DrawList& drawList)
+	// While a subtree records on a pool thread, its damage is collected here
+	// and reported by the thread that waits for it
+	static thread_local std::vector<Rect>* t_damageBuffer = nullptr;
+
+	void Widget::Paint(DrawList& drawList)
 	{
 		if (!visible_)
 			return;
 
+		Record(nullptr);
+		chain_.AppendTo(drawList);
+	}
+
+	const DrawChain& Widget::RecordChain(ThreadPool* pool)
+	{
+		Record(pool);
+		return chain_;
+	}
+
+	void Widget::Record(ThreadPool* pool)
+	{
+		if (!paintDirty_ && !childDirty_)
+			return;
+
+		// Only widgets on the path to a dirty descendant get here; clean
+		// children keep their recording and are linked as they are
+		if (paintDirty_)
+		{
+			fragment_.Clear();
+			RecordContent();
+		}
+		if (childDirty_)
+			RecordChildren(pool);
+
+		Rect subtreeRect = paintedRect_;
+		chain_.Clear();
+		chain_.Add(fragment_);
+		for (Widget* child : children_)
+		{
+			if (!child->visible_)
+				continue;
+			chain_.Add(child->chain_);
+			subtreeRect = UnionRect(subtreeRect, child->subtreeRect_);
+		}
+		subtreeRect_ = subtreeRect;
+		paintDirty_ = false;
+		partialPaint_ = false;
+		childDirty_ = false;
+	}
+
+	void Widget::RecordContent()
+	{
+		OnPaint(fragment_);
+
+		// The old extent was reported by Invalidate(); after InvalidateArea()
+		// the damage is already exact unless the extent itself moved
+		const Rect oldRect = paintedRect_;
+		paintedRect_ = GetCommandBounds(fragment_, 0, fragment_.GetCommands().size());
+		if (!partialPaint_)
+		{
+			AddDamage(paintedRect_);
+		}
+		else if (oldRect.x != paintedRect_.x || oldRect.y != paintedRect_.y || oldRect.width != paintedRect_.width ||
+		         oldRect.height != paintedRect_.height)
+		{
+			AddDamage(oldRect);
+			AddDamage(paintedRect_);
+		}
+	}
+
+	void Widget::RecordChildren(ThreadPool* pool)
+	{
+		if (!pool)
+		{
+			for (Widget* child : children_)
+			{
+				if (child->visible_)
+					child->Record(nullptr);
+			}
+			return;
+		}
+
+		// Every pending child collects its damage, wherever it records, so
+		// the root sees it in paint order
+		std::vector<std::vector<Rect>> damage(children_.size());
+		auto record = [this, &damage](size_t index) {
+			t_damageBuffer = &damage[index];
+			children_[index]->Record(nullptr);
+			t_damageBuffer = nullptr;
+		};
+
+		TaskGroup group;
+		for (size_t i = 0; i < children_.size(); ++i)
+		{
+			Widget* child = children_[i];
+			if (!child->visible_ || !child->IsPaintPending())
+				continue;
+
+			if (child->paintThreadSafeTree_ && child->IsPaintThreadSafe())
+				pool->Spawn(group, [&record, i] { record(i); });
+			else
+				record(i);
+		}
+		pool->Wait(group);
+
+		for (const std::vector<Rect>& rects : damage)
+		{
+			for (const Rect& rect : rects)
+			{
+				AddDamage(rect);
+			}
+		}
+	}
+
+	void Widget::OnPaint(DrawList& drawList)
+	{
 		// Default paint: draw border
 		drawList.AddRect(bounds_, Color(0.5f, 0.5f, 0.5f, 1.0f));
+	}
 
-		// Paint children
-		for (auto& child : children_)
+	void Widget::Invalidate()
+	{
+		if (!paintDirty_ || partialPaint_)
+			AddDamage(paintedRect_);
+		paintDirty_ = true;
+		partialPaint_ = false;
+		InvalidateParent();
+	}
+
+	void Widget::InvalidateArea(const Rect& rect)
+	{
+		// A full invalidation already covers the whole widget
+		if (paintDirty_ && !partialPaint_)
+			return;
+
+		AddDamage(rect);
+		paintDirty_ = true;
+		partialPaint_ = true;
+		InvalidateParent();
+	}
+
+	void Widget::AddDamage(const Rect& rect)
+	{
+		if (IsEmptyRect(rect))
+			return;
+
+		if (t_damageBuffer)
+			t_damageBuffer->push_back(rect);
+		else
+			GetRoot()->OnDamage(rect);
+	}
+
+	void Widget::InvalidateParent()
+	{
+		// Stop at the first ancestor that is already flagged; everything above
+		// it was flagged at the same time
+		for (Widget* ancestor = parent_; ancestor && !ancestor->childDirty_; ancestor = ancestor->parent_)
 		{
-			child->OnPaint(drawList);
+			ancestor->childDirty_ = true;
 		}
 	}
 
+	void Widget::SetVisible(bool visible)
+	{
+		if (visible_ == visible)
+			return;
+		visible_ = visible;
+		// A cached fragment appears or disappears as a whole; re-recording
+		// (if any) reports its own changes
+		AddDamage(subtreeRect_);
+		InvalidateParent();
+		GetRoot()->OnVisibilityChanged(*this);
+	}
+
+	bool Widget::IsPaintThreadSafe() const
+	{
+		return typeid(*this) == typeid(Widget);
+	}
+
 	void Widget::OnEvent(const Event& event)
 	{
-		// Forward events to children
-		for (auto& child : children_)
+		// Events are routed to their target by the window, not broadcast
+		(void)event;
+	}
+
+	void Widget::OnPreviewEvent(const Event& event)
+	{
+		(void)event;
+	}
+
+	Widget* Widget::GetRoot()
+	{
+		Widget* root = this;
+		while (root->parent_)
+		{
+			root = root->parent_;
+		}
+		return root;
+	}
+
+	bool Widget::IsVisibleInTree() const
+	{
+		for (const Widget* widget = this; widget; widget = widget->parent_)
+		{
+			if (!widget->visible_)
+				return false;
+		}
+		return true;
+	}
+
+	bool Widget::IsPaintedAfter(const Widget& other) const
+	{
+		if (this == &other)
+			return false;
+
+		int depthA = 0;
+		for (const Widget* w = parent_; w; w = w->parent_)
+			depthA++;
+		int depthB = 0;
+		for (const Widget* w = other.parent_; w; w = w->parent_)
+			depthB++;
+
+		// Bring both to the same depth; a widget is painted after its ancestors
+		const Widget* a = this;
+		const Widget* b = &other;
+		for (; depthA > depthB; --depthA)
+			a = a->parent_;
+		if (a == b)
+			return true;
+		for (; depthB > depthA; --depthB)
+			b = b->parent_;
+		if (a == b)
+			return false;
+
+		// Then climb to the children of the common ancestor and compare them
+		while (a->parent_ != b->parent_)
 		{
-			child->OnEvent(event);
+			a = a->parent_;
+			b = b->parent_;
 		}
+		return a->parent_ && a->siblingIndex_ > b->siblingIndex_;
+	}
+
+	Size Widget::OnMeasure()
+	{
+		return Size();
+	}
+
+	void Widget::InvalidateMeasure()
+	{
+		if (ownerLayout_)
+			ownerLayout_->InvalidateMeasure();
 	}
 
 	void Widget::SetBounds(const Rect& bounds)
 	{
 		bounds_ = bounds;
+		Invalidate();
+
+		Widget* root = GetRoot();
+		if (root != this)
+			root->OnDescendantMoved(*this);
 	}
 
 	void Widget::AddChild(std::shared_ptr<Widget> child)
 	{
+		ownedChildren_.push_back(child);
+		AddChild(child.get());
+	}
+
+	void Widget::AddChild(Widget* child)
+	{
+		child->parent_ = this;
+		child->siblingIndex_ = children_.size();
+		if (!child->paintThreadSafeTree_ || !child->IsPaintThreadSafe())
+		{
+			for (Widget* widget = this; widget && widget->paintThreadSafeTree_; widget = widget->parent_)
+			{
+				widget->paintThreadSafeTree_ = false;
+			}
+		}
 		children_.push_back(child);
+		GetRoot()->OnDescendantAttached(*child);
+		AddDamage(child->subtreeRect_);
+		childDirty_ = true;
+		InvalidateParent();
 	}
 
 } // namespace SnowUI
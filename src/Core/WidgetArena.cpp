@@ -0,0 +1,44 @@
+#include "SnowUI/Core/WidgetArena.h"
+#include "SnowUI/Core/Widget.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace SnowUI
+{
+
+	void* WidgetArena::Allocate(size_t size, size_t alignment)
+	{
+		const uintptr_t address = reinterpret_cast<uintptr_t>(cursor_);
+		const size_t padding = (alignment - address % alignment) % alignment;
+		if (!cursor_ || padding + size > remaining_)
+		{
+			// Oversized widgets get a block of their own
+			const size_t blockSize = std::max(kBlockSize, size + alignment);
+			blocks_.emplace_back(new unsigned char[blockSize]);
+			bytesReserved_ += blockSize;
+			cursor_ = blocks_.back().get();
+			remaining_ = blockSize;
+			return Allocate(size, alignment);
+		}
+
+		unsigned char* memory = cursor_ + padding;
+		cursor_ = memory + size;
+		remaining_ -= padding + size;
+		return memory;
+	}
+
+	void WidgetArena::Clear()
+	{
+		// Newest first, so a widget never outlives one created before it
+		for (size_t i = widgets_.size(); i-- > 0;)
+		{
+			widgets_[i]->~Widget();
+		}
+		widgets_.clear();
+		blocks_.clear();
+		cursor_ = nullptr;
+		remaining_ = 0;
+		bytesReserved_ = 0;
+	}
+
+} // namespace SnowUI
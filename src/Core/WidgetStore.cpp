@@ -0,0 +1,119 @@
+#include "SnowUI/Core/WidgetStore.h"
+#include "SnowUI/Core/Widget.h"
+
+namespace SnowUI
+{
+
+	WidgetSlot WidgetStore::AddTree(Widget& widget)
+	{
+		const WidgetSlot first = static_cast<WidgetSlot>(widgets_.size());
+
+		stack_.clear();
+		stack_.push_back(&widget);
+		while (!stack_.empty())
+		{
+			Widget* current = stack_.back();
+			stack_.pop_back();
+			if (current->storeSlot_ != kNoWidgetSlot)
+				continue;
+
+			current->storeSlot_ = static_cast<WidgetSlot>(widgets_.size());
+			widgets_.push_back(current);
+			bounds_.push_back(current->bounds_);
+			visible_.push_back(current->visible_ ? 1 : 0);
+			visibleInTree_.push_back(0);
+			parents_.push_back(current->parent_ ? current->parent_->storeSlot_ : kNoWidgetSlot);
+			paintOrder_.push_back(0);
+
+			const std::vector<Widget*>& children = current->GetChildren();
+			for (auto it = children.rbegin(); it != children.rend(); ++it)
+			{
+				stack_.push_back(*it);
+			}
+		}
+
+		if (widgets_.size() > first)
+		{
+			orderDirty_ = true;
+			visibilityDirty_ = true;
+		}
+		return first;
+	}
+
+	void WidgetStore::Clear()
+	{
+		for (Widget* widget : widgets_)
+		{
+			widget->storeSlot_ = kNoWidgetSlot;
+		}
+		bounds_.clear();
+		visible_.clear();
+		visibleInTree_.clear();
+		parents_.clear();
+		paintOrder_.clear();
+		paintSlots_.clear();
+		widgets_.clear();
+		orderDirty_ = false;
+		visibilityDirty_ = false;
+	}
+
+	void WidgetStore::SetVisible(WidgetSlot slot, bool visible)
+	{
+		const uint8_t value = visible ? 1 : 0;
+		if (visible_[slot] == value)
+			return;
+		visible_[slot] = value;
+		visibilityDirty_ = true;
+	}
+
+	void WidgetStore::RenumberPaintOrder()
+	{
+		// Slots are handed out depth first, but children attached later land
+		// at the end, so walk the tree again to get the real paint order
+		paintSlots_.clear();
+		stack_.clear();
+		for (size_t slot = 0; slot < widgets_.size(); ++slot)
+		{
+			if (parents_[slot] == kNoWidgetSlot)
+				stack_.push_back(widgets_[slot]);
+		}
+		while (!stack_.empty())
+		{
+			Widget* widget = stack_.back();
+			stack_.pop_back();
+			paintOrder_[widget->storeSlot_] = static_cast<uint32_t>(paintSlots_.size());
+			paintSlots_.push_back(widget->storeSlot_);
+
+			const std::vector<Widget*>& children = widget->GetChildren();
+			for (auto it = children.rbegin(); it != children.rend(); ++it)
+			{
+				stack_.push_back(*it);
+			}
+		}
+	}
+
+	void WidgetStore::Refresh()
+	{
+		if (orderDirty_)
+		{
+			RenumberPaintOrder();
+			orderDirty_ = false;
+			visibilityDirty_ = true;
+		}
+		if (!visibilityDirty_)
+			return;
+
+		// Parents come before their children in paint order, so each parent's
+		// flag is final by the time its children read it
+		const WidgetSlot* parents = parents_.data();
+		const uint8_t* visible = visible_.data();
+		uint8_t* inTree = visibleInTree_.data();
+		for (WidgetSlot slot : paintSlots_)
+		{
+			const WidgetSlot parent = parents[slot];
+			inTree[slot] = visible[slot] & (parent == kNoWidgetSlot ? 1 : inTree[parent]);
+		}
+		visibilityDirty_ = false;
+	}
+
+} // namespace SnowUI
@@ -1,12 +1,25 @@
 #include "SnowUI/Core/Window.h"
+#include <algorithm>
 #include <iostream>
 
 namespace SnowUI
 {
 
-	Window::Window() : backend_(nullptr), shouldClose_(false), hasWindow_(false)
+	static const Color kBackgroundColor(0.2f, 0.2f, 0.2f, 1.0f);
+
+	Window::Window()
+		: backend_(nullptr), shouldClose_(false), hasWindow_(false), onClose_(0), frameRequested_(false),
+		  layoutPool_(nullptr), layoutRunning_(false), paintPool_(nullptr), renderStopping_(false), frameSequence_(0),
+		  presentedFrames_(0), mouseCapture_(nullptr), focus_(nullptr), nextTimerId_(1), postBudget_(4000)
 	{
 		visible_ = false;
+		store_.AddTree(*this);
+		clearList_.AddClear(kBackgroundColor);
+	}
+
+	Window::~Window()
+	{
+		SetRenderThread(false);
 	}
 
 	bool Window::Create(const std::string& title, int width, int height, IRenderBackend* backend)
@@ -15,9 +28,15 @@ namespace SnowUI
 		bounds_ = Rect(0, 0, static_cast<float>(width), static_cast<float>(height));
 		backend_ = backend;
 		hasWindow_ = false;
+		damage_.Reset(width, height);
+		store_.SetBounds(0, bounds_);
+		hitGrid_.Rebuild(store_, width, height);
 
 		if (backend_)
 		{
+			// Platform input lands in eventQueue_ once the window exists
+			backend_->SetEventQueue(&eventQueue_);
+
 			// First create the window (which sets up the GL context)
 			hasWindow_ = backend_->CreateWindow(title, width, height);
 			if (!hasWindow_)
@@ -37,16 +56,19 @@ namespace SnowUI
 
 	void Window::Show()
 	{
-		visible_ = true;
+		SetVisible(true);
 	}
 
 	void Window::Close()
 	{
 		shouldClose_ = true;
-		if (onClose_)
-		{
-			onClose_();
-		}
+		close_.Emit();
+	}
+
+	void Window::SetOnClose(Delegate<void()> callback)
+	{
+		close_.Disconnect(onClose_);
+		onClose_ = callback ? close_.Connect(std::move(callback)) : 0;
 	}
 
 	bool Window::ShouldClose() const
@@ -78,15 +100,401 @@ namespace SnowUI
 		if (!visible_ || !backend_)
 			return;
 
-		backend_->BeginFrame();
+		const Clock::time_point start = Clock::now();
+		frameRequested_ = false;
+		UpdateLayout();
+		const bool threaded = renderThread_.joinable();
+		if (!threaded)
+			backend_->BeginFrame();
+
+		// An idle tree keeps the previous frame's commands as they are
+		const bool firstFrame = !HasRecordedFrame();
+		if (IsPaintPending() || firstFrame)
+		{
+			frameChain_.Clear();
+			frameChain_.Add(clearList_);
+			frameChain_.Add(RecordChain(paintPool_));
+		}
+		if (firstFrame)
+		{
+			damage_.AddAll();
+		}
+
+		if (threaded)
+		{
+			PublishFrame();
+		}
+		else
+		{
+			// The backend may widen the damage, e.g. after a resize
+			backend_->ExecuteDrawChainPartial(frameChain_, damage_);
+			backend_->EndFrame();
+		}
+
+		frameStats_.pixelsRedrawn = damage_.GetArea();
+		frameStats_.damageRectCount = static_cast<uint32_t>(damage_.GetRects().size());
+		damage_.Reset(static_cast<int>(bounds_.width), static_cast<int>(bounds_.height));
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+		frameStats_.renderTimeUs = static_cast<uint64_t>(elapsed.count());
+		frameTimes_.Add(frameStats_.renderTimeUs);
+	}
+
+	void Window::PublishFrame()
+	{
+		// The recording stays with the widgets for the next frame, so the
+		// render thread gets its own copy
+		RenderFrame& frame = frames_.GetWriteBuffer();
+		frameChain_.Flatten(frame.drawList);
+		frame.damage = damage_;
+		frame.width = static_cast<int>(bounds_.width);
+		frame.height = static_cast<int>(bounds_.height);
+		frame.sequence = ++frameSequence_;
+
+		renderStats_.published++;
+		if (!frames_.Publish())
+			renderStats_.dropped++;
+
+		// Taking the lock orders the publish before the render thread's check
+		// of it, so the wakeup cannot be missed
+		{
+			std::lock_guard<std::mutex> lock(renderMutex_);
+		}
+		renderWake_.notify_one();
+	}
+
+	void Window::RenderThreadLoop(uint64_t sequence, int width, int height)
+	{
+		backend_->MakeContextCurrent(true);
+
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(renderMutex_);
+				renderWake_.wait(lock, [this] { return renderStopping_ || frames_.HasFresh(); });
+				if (renderStopping_)
+					break;
+			}
+
+			frames_.Acquire();
+			RenderFrame& frame = frames_.GetReadBuffer();
+			if (frame.width != width || frame.height != height)
+			{
+				width = frame.width;
+				height = frame.height;
+				backend_->Resize(width, height);
+				frame.damage.AddAll();
+			}
+
+			// The damage of frames replaced before they were drawn is gone
+			if (frame.sequence != sequence + 1)
+				frame.damage.AddAll();
+			sequence = frame.sequence;
+
+			backend_->BeginFrame();
+			backend_->ExecuteDrawListPartial(frame.drawList, frame.damage);
+			backend_->EndFrame();
+			presentedFrames_.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		backend_->MakeContextCurrent(false);
+	}
+
+	void Window::SetRenderThread(bool enabled)
+	{
+		if (enabled == renderThread_.joinable() || !backend_)
+			return;
+
+		if (enabled)
+		{
+			backend_->SetDetachedRendering(true);
+			renderStopping_ = false;
+			renderThread_ = std::thread(&Window::RenderThreadLoop, this, frameSequence_,
+			                            static_cast<int>(bounds_.width), static_cast<int>(bounds_.height));
+		}
+		else
+		{
+			{
+				std::lock_guard<std::mutex> lock(renderMutex_);
+				renderStopping_ = true;
+			}
+			renderWake_.notify_one();
+			renderThread_.join();
+			backend_->SetDetachedRendering(false);
+		}
+
+		// The other thread's last frame may be behind; start with a full one
+		damage_.AddAll();
+		RequestFrame();
+	}
+
+	RenderThreadStats Window::GetRenderThreadStats() const
+	{
+		RenderThreadStats stats = renderStats_;
+		stats.presented = presentedFrames_.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	void Window::OnDamage(const Rect& rect)
+	{
+		damage_.Add(rect);
+	}
+
+	void Window::OnDescendantAttached(Widget& child)
+	{
+		const WidgetSlot first = store_.AddTree(child);
+		hitGrid_.Insert(store_, first, static_cast<WidgetSlot>(store_.GetCount()));
+	}
+
+	void Window::OnDescendantMoved(Widget& widget)
+	{
+		const WidgetSlot slot = widget.GetStoreSlot();
+		store_.SetBounds(slot, widget.GetBounds());
+		if (layoutRunning_)
+			movedSlots_.push_back(slot);
+		else
+			hitGrid_.Update(store_, slot);
+	}
+
+	void Window::OnVisibilityChanged(Widget& widget)
+	{
+		store_.SetVisible(widget.GetStoreSlot(), widget.IsVisible());
+	}
+
+	void Window::SetPaintPool(ThreadPool* pool)
+	{
+		// Both modes record the same chains, so the cached recordings stay valid
+		paintPool_ = pool;
+	}
+
+	bool Window::HasRecordedFrame() const
+	{
+		return !frameChain_.IsEmpty();
+	}
+
+	void Window::SetLayout(std::shared_ptr<Layout> layout)
+	{
+		layout_ = std::move(layout);
+		UpdateLayout();
+	}
+
+	void Window::UpdateLayout()
+	{
+		if (!layout_)
+			return;
+
+		// Widgets the layout moves are re-indexed once it is done; when most
+		// of them moved, one rebuild beats updating each
+		layoutRunning_ = true;
+		layout_->DoLayout(Rect(0, 0, bounds_.width, bounds_.height), layoutPool_);
+		layoutRunning_ = false;
+
+		if (movedSlots_.size() > store_.GetCount() / 8)
+		{
+			hitGrid_.Rebuild(store_, static_cast<int>(bounds_.width), static_cast<int>(bounds_.height));
+		}
+		else
+		{
+			for (WidgetSlot slot : movedSlots_)
+			{
+				hitGrid_.Update(store_, slot);
+			}
+		}
+		movedSlots_.clear();
+	}
+
+	Widget* Window::HitTest(float x, float y)
+	{
+		store_.Refresh();
+		const WidgetSlot slot = hitGrid_.HitTest(store_, x, y);
+		return slot != kNoWidgetSlot ? store_.GetWidget(slot) : nullptr;
+	}
+
+	void Window::OnResize(int width, int height)
+	{
+		if (width <= 0 || height <= 0)
+			return;
+
+		bounds_.width = static_cast<float>(width);
+		bounds_.height = static_cast<float>(height);
+		damage_.Reset(width, height);
+		damage_.AddAll();
+		store_.SetBounds(0, bounds_);
+		hitGrid_.Rebuild(store_, width, height);
+		UpdateLayout();
+		RequestFrame();
+	}
+
+	bool Window::DispatchEvent(const Event& event)
+	{
+		if (event.type == EventType::Resize)
+		{
+			OnResize(event.width, event.height);
+		}
+
+		Widget* target = this;
+		if (event.IsMouseEvent())
+		{
+			if (mouseCapture_)
+			{
+				target = mouseCapture_;
+			}
+			else if (Widget* hit = HitTest(static_cast<float>(event.x), static_cast<float>(event.y)))
+			{
+				target = hit;
+			}
 
-		drawList_.Clear();
-		drawList_.AddClear(Color(0.2f, 0.2f, 0.2f, 1.0f));
+			if (event.type == EventType::MouseDown)
+			{
+				mouseCapture_ = target != this ? target : nullptr;
+				focus_ = mouseCapture_;
+			}
+		}
+		else if (focus_ && focus_->IsVisibleInTree())
+		{
+			target = focus_;
+		}
 
-		OnPaint(drawList_);
+		// Path from the target up to this window
+		eventPath_.clear();
+		for (Widget* widget = target; widget; widget = widget->GetParent())
+		{
+			eventPath_.push_back(widget);
+		}
 
-		backend_->ExecuteDrawList(drawList_);
-		backend_->EndFrame();
+		Event routed = event;
+		routed.handled = false;
+
+		routed.phase = EventPhase::Capture;
+		for (size_t i = eventPath_.size(); i-- > 1 && !routed.handled;)
+		{
+			eventPath_[i]->OnPreviewEvent(routed);
+		}
+
+		if (!routed.handled)
+		{
+			routed.phase = EventPhase::Target;
+			target->OnEvent(routed);
+		}
+
+		routed.phase = EventPhase::Bubble;
+		for (size_t i = 1; i < eventPath_.size() && !routed.handled; ++i)
+		{
+			eventPath_[i]->OnEvent(routed);
+		}
+
+		if (event.type == EventType::MouseUp)
+		{
+			mouseCapture_ = nullptr;
+		}
+		return routed.handled;
+	}
+
+	void Window::QueueEvent(const Event& event)
+	{
+		eventQueue_.Push(event);
+		if (backend_)
+		{
+			backend_->PostEmptyEvent();
+		}
+	}
+
+	void Window::DispatchQueuedEvents()
+	{
+		eventQueue_.Drain(eventBatch_);
+		for (const Event& event : eventBatch_)
+		{
+			DispatchEvent(event);
+			eventQueue_.RecordDelivery(event, GetEventTimestamp());
+		}
+		eventBatch_.clear();
+	}
+
+	bool Window::NeedsFrame() const
+	{
+		return frameRequested_ || IsPaintPending() || !damage_.IsEmpty() || !HasRecordedFrame() ||
+		       (layout_ && layout_->IsLayoutPending());
+	}
+
+	double Window::GetWaitTimeout() const
+	{
+		if (timers_.empty())
+			return -1.0;
+
+		Clock::time_point next = timers_.front().due;
+		for (const auto& timer : timers_)
+		{
+			next = std::min(next, timer.due);
+		}
+		const double seconds = std::chrono::duration<double>(next - Clock::now()).count();
+		return std::max(seconds, 0.0);
+	}
+
+	void Window::Post(PostKey key, std::function<void()> task)
+	{
+		// Only the post that finds the queue empty needs to wake the loop
+		if (posts_.Push(key, std::move(task)) && backend_)
+		{
+			backend_->PostEmptyEvent();
+		}
+	}
+
+	void Window::RunPostedTasks()
+	{
+		posts_.Run(postBudget_);
+	}
+
+	TimerId Window::SetTimer(std::chrono::milliseconds interval, std::function<void()> callback, bool repeat)
+	{
+		Timer timer;
+		timer.id = nextTimerId_++;
+		timer.interval = std::max(interval, std::chrono::milliseconds(1));
+		timer.due = Clock::now() + timer.interval;
+		timer.repeat = repeat;
+		timer.callback = std::move(callback);
+		timers_.push_back(std::move(timer));
+		return timers_.back().id;
+	}
+
+	void Window::KillTimer(TimerId id)
+	{
+		timers_.erase(std::remove_if(timers_.begin(), timers_.end(), [id](const Timer& timer) { return timer.id == id; }),
+		              timers_.end());
+	}
+
+	void Window::RunTimers()
+	{
+		const Clock::time_point now = Clock::now();
+
+		// Callbacks may add or kill timers, so look each due timer up by id
+		std::vector<TimerId> due;
+		for (const auto& timer : timers_)
+		{
+			if (timer.due <= now)
+				due.push_back(timer.id);
+		}
+
+		for (TimerId id : due)
+		{
+			auto it = std::find_if(timers_.begin(), timers_.end(), [id](const Timer& timer) { return timer.id == id; });
+			if (it == timers_.end())
+				continue;
+
+			std::function<void()> callback = it->callback;
+			if (it->repeat)
+			{
+				// Skip missed periods instead of firing a burst after a stall
+				do
+				{
+					it->due += it->interval;
+				} while (it->due <= now);
+			}
+			else
+			{
+				timers_.erase(it);
+			}
+			callback();
+		}
 	}
 
 	void Window::Run()
@@ -104,8 +512,27 @@ namespace SnowUI
 
 		while (!ShouldClose())
 		{
-			Update();
-			Render();
+			// Block only when there is nothing to draw and no posted tasks left
+			// over; input, posted tasks, timers and resizes all end the wait
+			if (NeedsFrame() || posts_.HasBacklog())
+			{
+				Update();
+			}
+			else if (backend_->WaitEvents(GetWaitTimeout()))
+			{
+				RequestFrame();
+			}
+
+			// Input first, so handlers see it before tasks and timers that
+			// were scheduled after it arrived
+			DispatchQueuedEvents();
+			RunPostedTasks();
+			RunTimers();
+
+			if (NeedsFrame())
+			{
+				Render();
+			}
 		}
 
 		std::cout << "Window: Main loop ended" << std::endl;
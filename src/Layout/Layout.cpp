@@ -1,43 +1,477 @@
 #include "SnowUI/Layout/Layout.h"
+#include <algorithm>
 
 namespace SnowUI
 {
 
-	Layout::Layout(LayoutType type) : type_(type), spacing_(5)
+	static bool SameRect(const Rect& a, const Rect& b)
 	{
+		return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
 	}
 
-	void Layout::AddWidget(std::shared_ptr<Widget> widget)
+	// A grid without explicit tracks is a single Star track
+	static const std::vector<GridLength>& GetTracks(const std::vector<GridLength>& tracks)
 	{
-		widgets_.push_back(widget);
+		static const std::vector<GridLength> single = {GridLength::Star()};
+		return tracks.empty() ? single : tracks;
 	}
 
-	void Layout::DoLayout(const Rect& bounds)
+	// Clamps an item's first track and span into a grid of count tracks
+	static void ClampSpan(int& first, int& span, size_t count)
 	{
-		if (widgets_.empty())
+		const int last = static_cast<int>(count) - 1;
+		first = std::min(std::max(first, 0), last);
+		span = std::min(std::max(span, 1), last - first + 1);
+	}
+
+	Layout::Layout(LayoutType type) : type_(type), subtreeSize_(0), spacing_(5.0f), padding_(0.0f), parent_(nullptr),
+		  measureDirty_(true), arrangeDirty_(true), applyPending_(false)
+	{
+	}
+
+	Layout::~Layout()
+	{
+		for (Item& item : items_)
+		{
+			if (item.widget && item.widget->ownerLayout_ == this)
+				item.widget->ownerLayout_ = nullptr;
+			if (item.layout && item.layout->parent_ == this)
+				item.layout->parent_ = nullptr;
+		}
+	}
+
+	void Layout::AddWidget(std::shared_ptr<Widget> widget, const LayoutParams& params)
+	{
+		Item item;
+		item.widget = widget.get();
+		item.ownedWidget = std::move(widget);
+		item.params = params;
+		AddItem(std::move(item));
+	}
+
+	void Layout::AddWidget(Widget* widget, const LayoutParams& params)
+	{
+		Item item;
+		item.widget = widget;
+		item.params = params;
+		AddItem(std::move(item));
+	}
+
+	void Layout::AddLayout(std::shared_ptr<Layout> layout, const LayoutParams& params)
+	{
+		Item item;
+		item.layout = std::move(layout);
+		item.params = params;
+		AddItem(std::move(item));
+	}
+
+	void Layout::AddItem(Item item)
+	{
+		size_t added = 1;
+		if (item.widget)
+			item.widget->ownerLayout_ = this;
+		if (item.layout)
+		{
+			item.layout->parent_ = this;
+			added += item.layout->subtreeSize_;
+			childLayouts_.push_back(items_.size());
+		}
+		items_.push_back(std::move(item));
+
+		for (Layout* node = this; node; node = node->parent_)
+		{
+			node->subtreeSize_ += added;
+		}
+		InvalidateMeasure();
+	}
+
+	void Layout::SetSpacing(float spacing)
+	{
+		spacing_ = spacing;
+		InvalidateMeasure();
+	}
+
+	void Layout::SetPadding(float padding)
+	{
+		padding_ = padding;
+		InvalidateMeasure();
+	}
+
+	void Layout::SetColumns(std::vector<GridLength> columns)
+	{
+		columns_ = std::move(columns);
+		InvalidateMeasure();
+	}
+
+	void Layout::SetRows(std::vector<GridLength> rows)
+	{
+		rows_ = std::move(rows);
+		InvalidateMeasure();
+	}
+
+	void Layout::InvalidateMeasure()
+	{
+		// Ancestors of a dirty node are always dirty too
+		for (Layout* node = this; node && !node->measureDirty_; node = node->parent_)
+		{
+			node->measureDirty_ = true;
+			node->arrangeDirty_ = true;
+		}
+	}
+
+	void Layout::DoLayout(const Rect& bounds, ThreadPool* pool)
+	{
+		Arrange(bounds, pool);
+	}
+
+	template <typename Fn> void Layout::ForEachChildLayout(ThreadPool* pool, Fn&& fn)
+	{
+		if (!pool || pool->GetConcurrency() == 1 || subtreeSize_ < kParallelGrain)
+		{
+			for (size_t index : childLayouts_)
+			{
+				fn(items_[index]);
+			}
+			return;
+		}
+
+		// Runs of siblings worth a grain each become tasks; the remainder runs
+		// here while they do
+		TaskGroup group;
+		size_t begin = 0;
+		size_t weight = 0;
+		for (size_t end = 0; end < childLayouts_.size(); ++end)
+		{
+			weight += items_[childLayouts_[end]].layout->subtreeSize_ + 1;
+			if (weight < kParallelGrain)
+				continue;
+
+			pool->Spawn(group, [this, begin, end, &fn] {
+				for (size_t i = begin; i <= end; ++i)
+				{
+					fn(items_[childLayouts_[i]]);
+				}
+			});
+			begin = end + 1;
+			weight = 0;
+		}
+		for (size_t i = begin; i < childLayouts_.size(); ++i)
+		{
+			fn(items_[childLayouts_[i]]);
+		}
+		pool->Wait(group);
+	}
+
+	const Size& Layout::Measure(ThreadPool* pool)
+	{
+		if (!measureDirty_)
+			return desired_;
+
+		// Nested layouts first, so the loop below finds them measured
+		ForEachChildLayout(pool, [pool](Item& item) { item.layout->Measure(pool); });
+		for (Item& item : items_)
+		{
+			MeasureItem(item);
+		}
+
+		Size content;
+		switch (type_)
+		{
+		case LayoutType::Vertical:
+			content = MeasureStack(true);
+			break;
+		case LayoutType::Horizontal:
+			content = MeasureStack(false);
+			break;
+		case LayoutType::Grid:
+			content = MeasureGrid();
+			break;
+		case LayoutType::Dock:
+			content = MeasureDock();
+			break;
+		}
+
+		desired_ = Size(content.width + 2.0f * padding_, content.height + 2.0f * padding_);
+		measureDirty_ = false;
+		return desired_;
+	}
+
+	void Layout::MeasureItem(Item& item)
+	{
+		const LayoutParams& params = item.params;
+		Size size(params.width, params.height);
+		if (params.width < 0.0f || params.height < 0.0f)
+		{
+			// Nested layouts were measured already and answer from their cache
+			const Size measured = item.layout ? item.layout->Measure() : item.widget->OnMeasure();
+			if (params.width < 0.0f)
+				size.width = measured.width;
+			if (params.height < 0.0f)
+				size.height = measured.height;
+		}
+		item.desired = size;
+	}
+
+	void Layout::Arrange(const Rect& bounds, ThreadPool* pool)
+	{
+		Measure(pool);
+		ArrangeTree(bounds, pool);
+		ApplyBounds();
+	}
+
+	void Layout::ArrangeTree(const Rect& bounds, ThreadPool* pool)
+	{
+		if (!arrangeDirty_ && SameRect(bounds, arranged_))
 			return;
 
-		if (type_ == LayoutType::Vertical)
+		arranged_ = bounds;
+		arrangeDirty_ = false;
+		applyPending_ = true;
+
+		const Rect content(bounds.x + padding_, bounds.y + padding_, std::max(bounds.width - 2.0f * padding_, 0.0f),
+		                   std::max(bounds.height - 2.0f * padding_, 0.0f));
+		switch (type_)
 		{
-			float itemHeight = (bounds.height - spacing_ * (widgets_.size() - 1)) / widgets_.size();
-			float y = bounds.y;
+		case LayoutType::Vertical:
+			ArrangeStack(content, true);
+			break;
+		case LayoutType::Horizontal:
+			ArrangeStack(content, false);
+			break;
+		case LayoutType::Grid:
+			ArrangeGrid(content);
+			break;
+		case LayoutType::Dock:
+			ArrangeDock(content);
+			break;
+		}
 
-			for (auto& widget : widgets_)
+		ForEachChildLayout(pool, [pool](Item& item) { item.layout->ArrangeTree(item.rect, pool); });
+	}
+
+	void Layout::ApplyBounds()
+	{
+		if (!applyPending_)
+			return;
+		applyPending_ = false;
+
+		for (Item& item : items_)
+		{
+			if (item.layout)
+			{
+				item.layout->ApplyBounds();
+			}
+			else if (!SameRect(item.widget->GetBounds(), item.rect))
 			{
-				widget->SetBounds(Rect(bounds.x, y, bounds.width, itemHeight));
-				y += itemHeight + spacing_;
+				// SetBounds() repaints and re-indexes the widget, so skip it for
+				// widgets that stay put
+				item.widget->SetBounds(item.rect);
 			}
 		}
-		else if (type_ == LayoutType::Horizontal)
+	}
+
+	Size Layout::MeasureStack(bool vertical) const
+	{
+		float along = 0.0f;
+		float across = 0.0f;
+		for (const Item& item : items_)
+		{
+			along += vertical ? item.desired.height : item.desired.width;
+			across = std::max(across, vertical ? item.desired.width : item.desired.height);
+		}
+		if (!items_.empty())
+			along += spacing_ * static_cast<float>(items_.size() - 1);
+		return vertical ? Size(across, along) : Size(along, across);
+	}
+
+	void Layout::ArrangeStack(const Rect& content, bool vertical)
+	{
+		if (items_.empty())
+			return;
+
+		const float length = vertical ? content.height : content.width;
+		const float available = std::max(length - spacing_ * static_cast<float>(items_.size() - 1), 0.0f);
+
+		float total = 0.0f;
+		float totalStretch = 0.0f;
+		for (const Item& item : items_)
+		{
+			total += vertical ? item.desired.height : item.desired.width;
+			totalStretch += std::max(item.params.stretch, 0.0f);
+		}
+
+		// Leftover space goes to stretching items (or evenly to all); too
+		// little space shrinks every item in proportion to what it wanted
+		const float extra = available - total;
+		const float shrink = total > 0.0f ? available / total : 0.0f;
+		float position = vertical ? content.y : content.x;
+		for (Item& item : items_)
 		{
-			float itemWidth = (bounds.width - spacing_ * (widgets_.size() - 1)) / widgets_.size();
-			float x = bounds.x;
+			float size = vertical ? item.desired.height : item.desired.width;
+			if (extra < 0.0f)
+				size *= shrink;
+			else if (totalStretch > 0.0f)
+				size += extra * std::max(item.params.stretch, 0.0f) / totalStretch;
+			else
+				size += extra / static_cast<float>(items_.size());
+
+			const Rect rect = vertical ? Rect(content.x, position, content.width, size)
+			                           : Rect(position, content.y, size, content.height);
+			item.rect = rect;
+			position += size + spacing_;
+		}
+	}
 
-			for (auto& widget : widgets_)
+	Size Layout::MeasureGrid()
+	{
+		const std::vector<GridLength>& columns = GetTracks(columns_);
+		const std::vector<GridLength>& rows = GetTracks(rows_);
+		columnSizes_.assign(columns.size(), 0.0f);
+		rowSizes_.assign(rows.size(), 0.0f);
+
+		// Items spanning several tracks take what the tracks give them and do
+		// not size them
+		for (const Item& item : items_)
+		{
+			int column = item.params.column, columnSpan = item.params.columnSpan;
+			int row = item.params.row, rowSpan = item.params.rowSpan;
+			ClampSpan(column, columnSpan, columns.size());
+			ClampSpan(row, rowSpan, rows.size());
+			if (columnSpan == 1)
+				columnSizes_[column] = std::max(columnSizes_[column], item.desired.width);
+			if (rowSpan == 1)
+				rowSizes_[row] = std::max(rowSizes_[row], item.desired.height);
+		}
+
+		Size size;
+		for (size_t i = 0; i < columns.size(); ++i)
+		{
+			if (columns[i].unit == GridLength::Unit::Pixel)
+				columnSizes_[i] = columns[i].value;
+			size.width += columnSizes_[i];
+		}
+		for (size_t i = 0; i < rows.size(); ++i)
+		{
+			if (rows[i].unit == GridLength::Unit::Pixel)
+				rowSizes_[i] = rows[i].value;
+			size.height += rowSizes_[i];
+		}
+		size.width += spacing_ * static_cast<float>(columns.size() - 1);
+		size.height += spacing_ * static_cast<float>(rows.size() - 1);
+		return size;
+	}
+
+	void Layout::ResolveTracks(const std::vector<GridLength>& tracks, const std::vector<float>& measured, float length,
+	                           std::vector<float>& offsets) const
+	{
+		float fixed = spacing_ * static_cast<float>(tracks.size() - 1);
+		float totalWeight = 0.0f;
+		for (size_t i = 0; i < tracks.size(); ++i)
+		{
+			if (tracks[i].unit == GridLength::Unit::Star)
+				totalWeight += std::max(tracks[i].value, 0.0f);
+			else
+				fixed += measured[i];
+		}
+		const float leftover = std::max(length - fixed, 0.0f);
+
+		offsets.resize(tracks.size() + 1);
+		offsets[0] = 0.0f;
+		for (size_t i = 0; i < tracks.size(); ++i)
+		{
+			float size = measured[i];
+			if (tracks[i].unit == GridLength::Unit::Star)
+				size = totalWeight > 0.0f ? leftover * std::max(tracks[i].value, 0.0f) / totalWeight : 0.0f;
+			offsets[i + 1] = offsets[i] + size + spacing_;
+		}
+	}
+
+	void Layout::ArrangeGrid(const Rect& content)
+	{
+		const std::vector<GridLength>& columns = GetTracks(columns_);
+		const std::vector<GridLength>& rows = GetTracks(rows_);
+		ResolveTracks(columns, columnSizes_, content.width, columnOffsets_);
+		ResolveTracks(rows, rowSizes_, content.height, rowOffsets_);
+
+		for (Item& item : items_)
+		{
+			int column = item.params.column, columnSpan = item.params.columnSpan;
+			int row = item.params.row, rowSpan = item.params.rowSpan;
+			ClampSpan(column, columnSpan, columns.size());
+			ClampSpan(row, rowSpan, rows.size());
+
+			const float x = columnOffsets_[column];
+			const float y = rowOffsets_[row];
+			const float width = columnOffsets_[column + columnSpan] - x - spacing_;
+			const float height = rowOffsets_[row + rowSpan] - y - spacing_;
+			item.rect = Rect(content.x + x, content.y + y, width, height);
+		}
+	}
+
+	Size Layout::MeasureDock() const
+	{
+		// Edge items use up one axis of the space left for the items after
+		// them, so the extent along the other axis is the largest at any step
+		float usedWidth = 0.0f, usedHeight = 0.0f;
+		float maxWidth = 0.0f, maxHeight = 0.0f;
+		for (const Item& item : items_)
+		{
+			switch (item.params.dock)
+			{
+			case DockSide::Left:
+			case DockSide::Right:
+				maxHeight = std::max(maxHeight, usedHeight + item.desired.height);
+				usedWidth += item.desired.width + spacing_;
+				break;
+			case DockSide::Top:
+			case DockSide::Bottom:
+				maxWidth = std::max(maxWidth, usedWidth + item.desired.width);
+				usedHeight += item.desired.height + spacing_;
+				break;
+			case DockSide::Fill:
+				maxWidth = std::max(maxWidth, usedWidth + item.desired.width);
+				maxHeight = std::max(maxHeight, usedHeight + item.desired.height);
+				break;
+			}
+		}
+		return Size(std::max(maxWidth, usedWidth), std::max(maxHeight, usedHeight));
+	}
+
+	void Layout::ArrangeDock(const Rect& content)
+	{
+		Rect remaining = content;
+		for (Item& item : items_)
+		{
+			Rect rect = remaining;
+			float used = 0.0f;
+			switch (item.params.dock)
 			{
-				widget->SetBounds(Rect(x, bounds.y, itemWidth, bounds.height));
-				x += itemWidth + spacing_;
+			case DockSide::Left:
+				rect.width = std::min(item.desired.width, remaining.width);
+				used = std::min(rect.width + spacing_, remaining.width);
+				remaining.x += used;
+				remaining.width -= used;
+				break;
+			case DockSide::Right:
+				rect.width = std::min(item.desired.width, remaining.width);
+				rect.x = remaining.x + remaining.width - rect.width;
+				remaining.width -= std::min(rect.width + spacing_, remaining.width);
+				break;
+			case DockSide::Top:
+				rect.height = std::min(item.desired.height, remaining.height);
+				used = std::min(rect.height + spacing_, remaining.height);
+				remaining.y += used;
+				remaining.height -= used;
+				break;
+			case DockSide::Bottom:
+				rect.height = std::min(item.desired.height, remaining.height);
+				rect.y = remaining.y + remaining.height - rect.height;
+				remaining.height -= std::min(rect.height + spacing_, remaining.height);
+				break;
+			case DockSide::Fill:
+				break;
 			}
+			item.rect = rect;
 		}
 	}
 
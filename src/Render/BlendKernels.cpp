@@ -0,0 +1,451 @@
+#include "SnowUI/Render/BlendKernels.h"
+#include "SnowUI/Render/GeometryBatcher.h"
+#include <cstring>
+
+// SSE2 is part of the x86-64 baseline, so only 64-bit x86 builds take the SIMD path
+#if defined(__x86_64__) || defined(_M_X64)
+#define SNOWUI_BLEND_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SNOWUI_TARGET_AVX2
+#else
+#define SNOWUI_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define SNOWUI_BLEND_NEON
+#include <arm_neon.h>
+#endif
+
+namespace SnowUI
+{
+
+	static_assert(sizeof(Color) == 4 * sizeof(float), "Color must be four packed floats");
+
+	// ---------------------------------------------------------------------
+	// Scalar reference
+	// ---------------------------------------------------------------------
+
+	static uint8_t AlphaOf(uint32_t pixel)
+	{
+		uint8_t bytes[4];
+		std::memcpy(bytes, &pixel, sizeof(bytes));
+		return bytes[3];
+	}
+
+	static uint32_t PackRGBA(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+	{
+		const uint8_t bytes[4] = {static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b),
+		                          static_cast<uint8_t>(a)};
+		uint32_t pixel;
+		std::memcpy(&pixel, bytes, sizeof(pixel));
+		return pixel;
+	}
+
+	// Exact round(x / 255) for x in [0, 255 * 255]
+	static uint32_t Div255(uint32_t x)
+	{
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	// Multiplies all four channels by factor / 255, two channels per 32-bit lane
+	static uint32_t ScalePixel(uint32_t pixel, uint32_t factor)
+	{
+		uint32_t rb = (pixel & 0x00FF00FFu) * factor + 0x00800080u;
+		uint32_t ag = ((pixel >> 8) & 0x00FF00FFu) * factor + 0x00800080u;
+		rb = ((rb + ((rb >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+		ag = (ag + ((ag >> 8) & 0x00FF00FFu)) & 0xFF00FF00u;
+		return rb | ag;
+	}
+
+	static void FillSolidScalar(uint32_t* dst, size_t count, uint32_t src)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			dst[i] = src;
+		}
+	}
+
+	static void BlendSolidScalar(uint32_t* dst, size_t count, uint32_t src)
+	{
+		const uint32_t inv = 255u - AlphaOf(src);
+		if (inv == 0)
+		{
+			FillSolidScalar(dst, count, src);
+			return;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			dst[i] = src + ScalePixel(dst[i], inv);
+		}
+	}
+
+	static void BlendMaskScalar(uint32_t* dst, const uint8_t* coverage, size_t count, uint32_t src)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			uint32_t s = ScalePixel(src, coverage[i]);
+			dst[i] = s + ScalePixel(dst[i], 255u - AlphaOf(s));
+		}
+	}
+
+	uint32_t ColorToPremultipliedRGBA8(const Color& color)
+	{
+		uint32_t a = ColorToByte(color.a);
+		return PackRGBA(Div255(ColorToByte(color.r) * a), Div255(ColorToByte(color.g) * a),
+		                Div255(ColorToByte(color.b) * a), a);
+	}
+
+	// ---------------------------------------------------------------------
+	// SSE2 / AVX2
+	// ---------------------------------------------------------------------
+
+#ifdef SNOWUI_BLEND_X86
+
+	// round(x / 255) on 16-bit lanes holding values up to 255 * 255
+	static inline __m128i Div255SSE2(__m128i x)
+	{
+		x = _mm_add_epi16(x, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	}
+
+	static void FillSolidSSE2(uint32_t* dst, size_t count, uint32_t src)
+	{
+		const __m128i s = _mm_set1_epi32(static_cast<int>(src));
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+		}
+		FillSolidScalar(dst + i, count - i, src);
+	}
+
+	static void BlendSolidSSE2(uint32_t* dst, size_t count, uint32_t src)
+	{
+		const uint32_t invAlpha = 255u - AlphaOf(src);
+		if (invAlpha == 0)
+		{
+			FillSolidSSE2(dst, count, src);
+			return;
+		}
+
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i inv = _mm_set1_epi16(static_cast<short>(invAlpha));
+		const __m128i s = _mm_set1_epi32(static_cast<int>(src));
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+			__m128i lo = Div255SSE2(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv));
+			__m128i hi = Div255SSE2(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_add_epi8(_mm_packus_epi16(lo, hi), s));
+		}
+		BlendSolidScalar(dst + i, count - i, src);
+	}
+
+	static void BlendMaskSSE2(uint32_t* dst, const uint8_t* coverage, size_t count, uint32_t src)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i full = _mm_set1_epi16(255);
+		const __m128i s16 = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(src)), zero);
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			// Replicate each coverage byte across its pixel's four channels
+			int32_t c;
+			std::memcpy(&c, coverage + i, sizeof(c));
+			__m128i cov = _mm_cvtsi32_si128(c);
+			cov = _mm_unpacklo_epi8(cov, cov);
+			cov = _mm_unpacklo_epi16(cov, cov);
+
+			__m128i sLo = Div255SSE2(_mm_mullo_epi16(s16, _mm_unpacklo_epi8(cov, zero)));
+			__m128i sHi = Div255SSE2(_mm_mullo_epi16(s16, _mm_unpackhi_epi8(cov, zero)));
+			__m128i invLo = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sLo, 0xFF), 0xFF));
+			__m128i invHi = _mm_sub_epi16(full, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sHi, 0xFF), 0xFF));
+
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+			__m128i lo = _mm_add_epi16(sLo, Div255SSE2(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), invLo)));
+			__m128i hi = _mm_add_epi16(sHi, Div255SSE2(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), invHi)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+		}
+		BlendMaskScalar(dst + i, coverage + i, count - i, src);
+	}
+
+	SNOWUI_TARGET_AVX2 static inline __m256i Div255AVX2(__m256i x)
+	{
+		x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+		return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+	}
+
+	SNOWUI_TARGET_AVX2 static void FillSolidAVX2(uint32_t* dst, size_t count, uint32_t src)
+	{
+		const __m256i s = _mm256_set1_epi32(static_cast<int>(src));
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), s);
+		}
+		FillSolidScalar(dst + i, count - i, src);
+	}
+
+	SNOWUI_TARGET_AVX2 static void BlendSolidAVX2(uint32_t* dst, size_t count, uint32_t src)
+	{
+		const uint32_t invAlpha = 255u - AlphaOf(src);
+		if (invAlpha == 0)
+		{
+			FillSolidAVX2(dst, count, src);
+			return;
+		}
+
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i inv = _mm256_set1_epi16(static_cast<short>(invAlpha));
+		const __m256i s = _mm256_set1_epi32(static_cast<int>(src));
+
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+			__m256i lo = Div255AVX2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), inv));
+			__m256i hi = Div255AVX2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), inv));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_add_epi8(_mm256_packus_epi16(lo, hi), s));
+		}
+		BlendSolidScalar(dst + i, count - i, src);
+	}
+
+	SNOWUI_TARGET_AVX2 static void BlendMaskAVX2(uint32_t* dst, const uint8_t* coverage, size_t count, uint32_t src)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i full = _mm256_set1_epi16(255);
+		const __m256i splat = _mm256_set1_epi32(0x01010101);
+		const __m256i s16 = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(src)), zero);
+
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			// One coverage value per 32-bit lane, then replicated into all four bytes.
+			// Unpacking works per 128-bit half, matching how the pixels are unpacked.
+			__m256i cov = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(coverage + i)));
+			cov = _mm256_mullo_epi32(cov, splat);
+
+			__m256i sLo = Div255AVX2(_mm256_mullo_epi16(s16, _mm256_unpacklo_epi8(cov, zero)));
+			__m256i sHi = Div255AVX2(_mm256_mullo_epi16(s16, _mm256_unpackhi_epi8(cov, zero)));
+			__m256i invLo = _mm256_sub_epi16(full, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sLo, 0xFF), 0xFF));
+			__m256i invHi = _mm256_sub_epi16(full, _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sHi, 0xFF), 0xFF));
+
+			__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+			__m256i lo = _mm256_add_epi16(sLo, Div255AVX2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), invLo)));
+			__m256i hi = _mm256_add_epi16(sHi, Div255AVX2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), invHi)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+		}
+		BlendMaskScalar(dst + i, coverage + i, count - i, src);
+	}
+
+	static void ColorsToPremultipliedSSE2(const Color* colors, uint32_t* out, size_t count)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 scale = _mm_set1_ps(255.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128i alphaMask = _mm_set_epi32(-1, 0, 0, 0);
+		const __m128i bias = _mm_set1_epi32(128);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			// Same rounding as ColorToByte: clamp, then truncate v * 255 + 0.5
+			__m128 v = _mm_loadu_ps(&colors[i].r);
+			v = _mm_min_ps(_mm_max_ps(v, zero), one);
+			__m128i c = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+
+			// Products fit in 16 bits, so a 16-bit multiply is exact on each 32-bit lane
+			__m128i t = _mm_add_epi32(_mm_mullo_epi16(c, _mm_shuffle_epi32(c, 0xFF)), bias);
+			t = _mm_srli_epi32(_mm_add_epi32(t, _mm_srli_epi32(t, 8)), 8);
+			t = _mm_or_si128(_mm_andnot_si128(alphaMask, t), _mm_and_si128(alphaMask, c));
+
+			t = _mm_packs_epi32(t, t);
+			t = _mm_packus_epi16(t, t);
+			out[i] = static_cast<uint32_t>(_mm_cvtsi128_si32(t));
+		}
+	}
+
+	static bool CpuHasAVX2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+#endif // SNOWUI_BLEND_X86
+
+	// ---------------------------------------------------------------------
+	// NEON
+	// ---------------------------------------------------------------------
+
+#ifdef SNOWUI_BLEND_NEON
+
+	// round(x / 255) narrowed to bytes: (x + ((x + 128) >> 8) + 128) >> 8
+	static inline uint8x8_t Div255NEON(uint16x8_t x)
+	{
+		return vraddhn_u16(x, vrshrq_n_u16(x, 8));
+	}
+
+	static void FillSolidNEON(uint32_t* dst, size_t count, uint32_t src)
+	{
+		const uint32x4_t s = vdupq_n_u32(src);
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			vst1q_u32(dst + i, s);
+		}
+		FillSolidScalar(dst + i, count - i, src);
+	}
+
+	static void BlendSolidNEON(uint32_t* dst, size_t count, uint32_t src)
+	{
+		const uint32_t invAlpha = 255u - AlphaOf(src);
+		if (invAlpha == 0)
+		{
+			FillSolidNEON(dst, count, src);
+			return;
+		}
+
+		const uint8x8_t inv = vdup_n_u8(static_cast<uint8_t>(invAlpha));
+		const uint8x16_t s = vreinterpretq_u8_u32(vdupq_n_u32(src));
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+			uint8x8_t lo = Div255NEON(vmull_u8(vget_low_u8(d), inv));
+			uint8x8_t hi = Div255NEON(vmull_u8(vget_high_u8(d), inv));
+			vst1q_u32(dst + i, vreinterpretq_u32_u8(vaddq_u8(vcombine_u8(lo, hi), s)));
+		}
+		BlendSolidScalar(dst + i, count - i, src);
+	}
+
+	static void BlendMaskNEON(uint32_t* dst, const uint8_t* coverage, size_t count, uint32_t src)
+	{
+		static const uint8_t kSplatLo[8] = {0, 0, 0, 0, 1, 1, 1, 1};
+		static const uint8_t kSplatHi[8] = {2, 2, 2, 2, 3, 3, 3, 3};
+		static const uint8_t kAlpha[8] = {3, 3, 3, 3, 7, 7, 7, 7};
+		const uint8x8_t splatLo = vld1_u8(kSplatLo);
+		const uint8x8_t splatHi = vld1_u8(kSplatHi);
+		const uint8x8_t alphaIdx = vld1_u8(kAlpha);
+		const uint8x8_t s = vreinterpret_u8_u32(vdup_n_u32(src));
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			uint32_t c;
+			std::memcpy(&c, coverage + i, sizeof(c));
+			uint8x8_t cov = vreinterpret_u8_u32(vdup_n_u32(c));
+
+			uint8x8_t sLo = Div255NEON(vmull_u8(s, vtbl1_u8(cov, splatLo)));
+			uint8x8_t sHi = Div255NEON(vmull_u8(s, vtbl1_u8(cov, splatHi)));
+			uint8x8_t invLo = vmvn_u8(vtbl1_u8(sLo, alphaIdx));
+			uint8x8_t invHi = vmvn_u8(vtbl1_u8(sHi, alphaIdx));
+
+			uint8x16_t d = vreinterpretq_u8_u32(vld1q_u32(dst + i));
+			uint8x8_t lo = vadd_u8(sLo, Div255NEON(vmull_u8(vget_low_u8(d), invLo)));
+			uint8x8_t hi = vadd_u8(sHi, Div255NEON(vmull_u8(vget_high_u8(d), invHi)));
+			vst1q_u32(dst + i, vreinterpretq_u32_u8(vcombine_u8(lo, hi)));
+		}
+		BlendMaskScalar(dst + i, coverage + i, count - i, src);
+	}
+
+#endif // SNOWUI_BLEND_NEON
+
+	// ---------------------------------------------------------------------
+	// Dispatch
+	// ---------------------------------------------------------------------
+
+	static const BlendKernels kScalarKernels = {BlendISA::Scalar, FillSolidScalar, BlendSolidScalar, BlendMaskScalar};
+#ifdef SNOWUI_BLEND_X86
+	static const BlendKernels kSSE2Kernels = {BlendISA::SSE2, FillSolidSSE2, BlendSolidSSE2, BlendMaskSSE2};
+	static const BlendKernels kAVX2Kernels = {BlendISA::AVX2, FillSolidAVX2, BlendSolidAVX2, BlendMaskAVX2};
+#endif
+#ifdef SNOWUI_BLEND_NEON
+	static const BlendKernels kNEONKernels = {BlendISA::NEON, FillSolidNEON, BlendSolidNEON, BlendMaskNEON};
+#endif
+
+	const BlendKernels& GetBlendKernels(BlendISA isa)
+	{
+		switch (isa)
+		{
+#ifdef SNOWUI_BLEND_X86
+		case BlendISA::SSE2:
+			return kSSE2Kernels;
+		case BlendISA::AVX2:
+			if (CpuHasAVX2())
+				return kAVX2Kernels;
+			break;
+#endif
+#ifdef SNOWUI_BLEND_NEON
+		case BlendISA::NEON:
+			return kNEONKernels;
+#endif
+		default:
+			break;
+		}
+		return kScalarKernels;
+	}
+
+	const BlendKernels& GetBlendKernels()
+	{
+		static const BlendKernels& best = []() -> const BlendKernels& {
+			const BlendISA preferred[] = {BlendISA::AVX2, BlendISA::SSE2, BlendISA::NEON};
+			for (BlendISA isa : preferred)
+			{
+				const BlendKernels& kernels = GetBlendKernels(isa);
+				if (kernels.isa == isa)
+					return kernels;
+			}
+			return kScalarKernels;
+		}();
+		return best;
+	}
+
+	const char* GetBlendISAName(BlendISA isa)
+	{
+		switch (isa)
+		{
+		case BlendISA::Scalar:
+			return "Scalar";
+		case BlendISA::SSE2:
+			return "SSE2";
+		case BlendISA::AVX2:
+			return "AVX2";
+		case BlendISA::NEON:
+			return "NEON";
+		}
+		return "Unknown";
+	}
+
+	void ColorsToPremultipliedRGBA8(const Color* colors, uint32_t* out, size_t count)
+	{
+#ifdef SNOWUI_BLEND_X86
+		ColorsToPremultipliedSSE2(colors, out, count);
+#else
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = ColorToPremultipliedRGBA8(colors[i]);
+		}
+#endif
+	}
+
+} // namespace SnowUI
@@ -0,0 +1,154 @@
+#include "SnowUI/Render/DamageRegion.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SnowUI
+{
+
+	static bool Intersects(const DamageRect& a, const DamageRect& b)
+	{
+		return a.x < b.Right() && b.x < a.Right() && a.y < b.Bottom() && b.y < a.Bottom();
+	}
+
+	static DamageRect Union(const DamageRect& a, const DamageRect& b)
+	{
+		const int x0 = std::min(a.x, b.x);
+		const int y0 = std::min(a.y, b.y);
+		const int x1 = std::max(a.Right(), b.Right());
+		const int y1 = std::max(a.Bottom(), b.Bottom());
+		return DamageRect{x0, y0, x1 - x0, y1 - y0};
+	}
+
+	void DamageRegion::Reset(int width, int height)
+	{
+		width_ = std::max(width, 0);
+		height_ = std::max(height, 0);
+		rects_.clear();
+	}
+
+	void DamageRegion::Add(const Rect& rect)
+	{
+		// One pixel of slack covers line rasterization and glyph rounding
+		const float x0 = std::floor(std::min(rect.x, rect.x + rect.width)) - 1.0f;
+		const float y0 = std::floor(std::min(rect.y, rect.y + rect.height)) - 1.0f;
+		const float x1 = std::ceil(std::max(rect.x, rect.x + rect.width)) + 1.0f;
+		const float y1 = std::ceil(std::max(rect.y, rect.y + rect.height)) + 1.0f;
+
+		const float maxX = static_cast<float>(width_);
+		const float maxY = static_cast<float>(height_);
+		const int ix0 = static_cast<int>(std::max(0.0f, std::min(x0, maxX)));
+		const int iy0 = static_cast<int>(std::max(0.0f, std::min(y0, maxY)));
+		const int ix1 = static_cast<int>(std::max(0.0f, std::min(x1, maxX)));
+		const int iy1 = static_cast<int>(std::max(0.0f, std::min(y1, maxY)));
+		Add(DamageRect{ix0, iy0, ix1 - ix0, iy1 - iy0});
+	}
+
+	void DamageRegion::Add(const DamageRect& rect)
+	{
+		DamageRect merged;
+		merged.x = std::max(rect.x, 0);
+		merged.y = std::max(rect.y, 0);
+		merged.width = std::min(rect.Right(), width_) - merged.x;
+		merged.height = std::min(rect.Bottom(), height_) - merged.y;
+		if (merged.width <= 0 || merged.height <= 0)
+			return;
+
+		// Absorb every rect the new one overlaps; the union may overlap rects
+		// that were disjoint from the original, so repeat until stable
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (size_t i = 0; i < rects_.size(); ++i)
+			{
+				if (Intersects(rects_[i], merged))
+				{
+					merged = Union(rects_[i], merged);
+					rects_[i] = rects_.back();
+					rects_.pop_back();
+					changed = true;
+					break;
+				}
+			}
+		}
+
+		if (rects_.size() >= kMaxRects)
+		{
+			for (const auto& r : rects_)
+			{
+				merged = Union(r, merged);
+			}
+			rects_.clear();
+		}
+		rects_.push_back(merged);
+	}
+
+	void DamageRegion::Add(const DamageRegion& other)
+	{
+		for (const auto& rect : other.rects_)
+		{
+			Add(rect);
+		}
+	}
+
+	void DamageRegion::AddAll()
+	{
+		rects_.clear();
+		if (width_ > 0 && height_ > 0)
+			rects_.push_back(DamageRect{0, 0, width_, height_});
+	}
+
+	bool DamageRegion::IsFull() const
+	{
+		return rects_.size() == 1 && rects_[0].x == 0 && rects_[0].y == 0 && rects_[0].width == width_ &&
+		       rects_[0].height == height_;
+	}
+
+	uint64_t DamageRegion::GetArea() const
+	{
+		uint64_t area = 0;
+		for (const auto& rect : rects_)
+		{
+			area += static_cast<uint64_t>(rect.width) * static_cast<uint64_t>(rect.height);
+		}
+		return area;
+	}
+
+	void DamageHistory::Accumulate(DamageRegion& damage)
+	{
+		if (bufferAge_ <= 0)
+		{
+			damage.AddAll();
+			return;
+		}
+
+		if (damage.GetWidth() != width_ || damage.GetHeight() != height_)
+		{
+			width_ = damage.GetWidth();
+			height_ = damage.GetHeight();
+			Reset();
+		}
+
+		const DamageRegion current = damage;
+		if (fullFramesLeft_ > 0)
+		{
+			// Every buffer in the chain is drawn in full once before its
+			// content can be trusted
+			fullFramesLeft_--;
+			damage.AddAll();
+		}
+		else
+		{
+			for (const auto& frame : frames_)
+			{
+				damage.Add(frame);
+			}
+		}
+
+		frames_.push_back(current);
+		while (frames_.size() >= static_cast<size_t>(bufferAge_))
+		{
+			frames_.pop_front();
+		}
+	}
+
+} // namespace SnowUI
@@ -0,0 +1,221 @@
+#include "SnowUI/Render/Font.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+
+#ifdef SNOWUI_FREETYPE_ENABLED
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+namespace SnowUI
+{
+
+	struct FontRegistry::Face
+	{
+		std::string path;
+#ifdef SNOWUI_FREETYPE_ENABLED
+		FT_Face face = nullptr;
+#endif
+		uint16_t selectedSize = 0;
+	};
+
+	// Built-in box font: advance is 7/12 of the size, boxes are one pixel
+	// narrower than the advance and as tall as the font size.
+	static float BuiltinAdvance(uint16_t size)
+	{
+		return std::round(size * 7.0f / 12.0f);
+	}
+
+	static bool IsBlank(uint32_t codepoint)
+	{
+		return codepoint == ' ' || codepoint == '\t' || codepoint == '\n' || codepoint == '\r';
+	}
+
+	FontRegistry& FontRegistry::Instance()
+	{
+		static FontRegistry registry;
+		return registry;
+	}
+
+	FontRegistry::FontRegistry() : library_(nullptr), generation_(0)
+	{
+#ifdef SNOWUI_FREETYPE_ENABLED
+		FT_Library library = nullptr;
+		if (FT_Init_FreeType(&library) != 0)
+		{
+			std::cerr << "FontRegistry: Failed to initialize FreeType" << std::endl;
+			library = nullptr;
+		}
+		library_ = library;
+#endif
+		// Slot 0 is the built-in font
+		faces_.emplace_back(new Face());
+	}
+
+	FontRegistry::~FontRegistry()
+	{
+#ifdef SNOWUI_FREETYPE_ENABLED
+		for (auto& face : faces_)
+		{
+			if (face->face)
+				FT_Done_Face(face->face);
+		}
+		if (library_)
+			FT_Done_FreeType(static_cast<FT_Library>(library_));
+#endif
+	}
+
+	FontId FontRegistry::LoadFont(const std::string& path)
+	{
+#ifdef SNOWUI_FREETYPE_ENABLED
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (!library_ || faces_.size() >= kInvalidFont)
+			return kInvalidFont;
+
+		for (size_t i = 1; i < faces_.size(); ++i)
+		{
+			if (faces_[i]->path == path)
+				return static_cast<FontId>(i);
+		}
+
+		FT_Face ftFace = nullptr;
+		if (FT_New_Face(static_cast<FT_Library>(library_), path.c_str(), 0, &ftFace) != 0)
+		{
+			std::cerr << "FontRegistry: Failed to load font '" << path << "'" << std::endl;
+			return kInvalidFont;
+		}
+
+		std::unique_ptr<Face> face(new Face());
+		face->path = path;
+		face->face = ftFace;
+		faces_.push_back(std::move(face));
+		generation_.fetch_add(1, std::memory_order_release);
+		return static_cast<FontId>(faces_.size() - 1);
+#else
+		std::cerr << "FontRegistry: FreeType not available, cannot load '" << path << "'" << std::endl;
+		return kInvalidFont;
+#endif
+	}
+
+	FontRegistry::Face* FontRegistry::FindFace(FontId font)
+	{
+		if (font == kDefaultFont || font >= faces_.size())
+			return nullptr;
+		return faces_[font].get();
+	}
+
+	bool FontRegistry::SelectSize(Face* face, uint16_t size)
+	{
+#ifdef SNOWUI_FREETYPE_ENABLED
+		if (face->selectedSize == size)
+			return true;
+		if (FT_Set_Pixel_Sizes(face->face, 0, size) != 0)
+			return false;
+		face->selectedSize = size;
+		return true;
+#else
+		(void)face;
+		(void)size;
+		return false;
+#endif
+	}
+
+	FontMetrics FontRegistry::GetMetrics(FontId font, uint16_t size)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		FontMetrics metrics;
+		metrics.ascent = static_cast<float>(size);
+		metrics.lineHeight = static_cast<float>(size);
+
+#ifdef SNOWUI_FREETYPE_ENABLED
+		Face* face = FindFace(font);
+		if (face && SelectSize(face, size))
+		{
+			metrics.ascent = face->face->size->metrics.ascender / 64.0f;
+			metrics.lineHeight = face->face->size->metrics.height / 64.0f;
+		}
+#else
+		(void)font;
+#endif
+		return metrics;
+	}
+
+	float FontRegistry::GetAdvance(FontId font, uint16_t size, uint32_t codepoint)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+#ifdef SNOWUI_FREETYPE_ENABLED
+		Face* face = FindFace(font);
+		if (face && SelectSize(face, size))
+		{
+			if (FT_Load_Char(face->face, codepoint, FT_LOAD_DEFAULT) == 0)
+				return face->face->glyph->advance.x / 64.0f;
+			return 0.0f;
+		}
+#else
+		(void)font;
+		(void)codepoint;
+#endif
+		return BuiltinAdvance(size);
+	}
+
+	bool FontRegistry::RasterizeGlyph(FontId font, uint16_t size, uint32_t codepoint, GlyphBitmap& out)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+
+#ifdef SNOWUI_FREETYPE_ENABLED
+		Face* face = FindFace(font);
+		if (face)
+		{
+			if (!SelectSize(face, size) || FT_Load_Char(face->face, codepoint, FT_LOAD_RENDER) != 0)
+				return false;
+
+			const FT_GlyphSlot slot = face->face->glyph;
+			const FT_Bitmap& bitmap = slot->bitmap;
+			out.width = static_cast<int>(bitmap.width);
+			out.height = static_cast<int>(bitmap.rows);
+			out.bearingX = slot->bitmap_left;
+			out.bearingY = slot->bitmap_top;
+			out.advance = slot->advance.x / 64.0f;
+			out.coverage.resize(static_cast<size_t>(out.width) * out.height);
+
+			for (int y = 0; y < out.height; ++y)
+			{
+				const uint8_t* src = bitmap.buffer + static_cast<ptrdiff_t>(y) * bitmap.pitch;
+				uint8_t* dst = out.coverage.data() + static_cast<size_t>(y) * out.width;
+				if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+				{
+					for (int x = 0; x < out.width; ++x)
+						dst[x] = (src[x >> 3] & (0x80 >> (x & 7))) ? 255 : 0;
+				}
+				else
+				{
+					std::copy(src, src + out.width, dst);
+				}
+			}
+			return true;
+		}
+#else
+		(void)font;
+#endif
+
+		out.advance = BuiltinAdvance(size);
+		out.bearingX = 0;
+		out.bearingY = size;
+		if (IsBlank(codepoint))
+		{
+			out.width = 0;
+			out.height = 0;
+			out.coverage.clear();
+		}
+		else
+		{
+			out.width = std::max(1, static_cast<int>(out.advance) - 1);
+			out.height = size;
+			out.coverage.assign(static_cast<size_t>(out.width) * out.height, 255);
+		}
+		return true;
+	}
+
+} // namespace SnowUI
@@ -0,0 +1,253 @@
+#include "SnowUI/Render/GLBatchSubmitter.h"
+#include <iostream>
+
+#ifdef SNOWUI_GLFW_ENABLED
+#include <GLFW/glfw3.h>
+#endif
+
+#ifdef SNOWUI_OPENGL_ENABLED
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+#endif
+
+// Buffer objects are above GL 1.1 and are resolved through GLFW; without
+// either GL or GLFW there is never a context to draw into.
+#if defined(SNOWUI_OPENGL_ENABLED) && defined(SNOWUI_GLFW_ENABLED)
+#define SNOWUI_GLBATCH_ENABLED
+#endif
+
+namespace SnowUI
+{
+
+#ifdef SNOWUI_GLBATCH_ENABLED
+
+#ifdef _WIN32
+#define SNOWUI_GLAPI __stdcall
+#else
+#define SNOWUI_GLAPI
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_UNPACK_ROW_LENGTH
+#define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
+
+	// GL 1.5 buffer object entry points
+	struct GLBufferFunctions
+	{
+		void(SNOWUI_GLAPI* GenBuffers)(GLsizei, GLuint*);
+		void(SNOWUI_GLAPI* DeleteBuffers)(GLsizei, const GLuint*);
+		void(SNOWUI_GLAPI* BindBuffer)(GLenum, GLuint);
+		void(SNOWUI_GLAPI* BufferData)(GLenum, std::ptrdiff_t, const void*, GLenum);
+		void(SNOWUI_GLAPI* BufferSubData)(GLenum, std::ptrdiff_t, std::ptrdiff_t, const void*);
+	};
+
+	static GLBufferFunctions g_buffers;
+
+	template <typename T> static bool LoadProc(T& fn, const char* name)
+	{
+		fn = reinterpret_cast<T>(glfwGetProcAddress(name));
+		return fn != nullptr;
+	}
+
+	static bool LoadBufferFunctions()
+	{
+		bool ok = true;
+		ok &= LoadProc(g_buffers.GenBuffers, "glGenBuffers");
+		ok &= LoadProc(g_buffers.DeleteBuffers, "glDeleteBuffers");
+		ok &= LoadProc(g_buffers.BindBuffer, "glBindBuffer");
+		ok &= LoadProc(g_buffers.BufferData, "glBufferData");
+		ok &= LoadProc(g_buffers.BufferSubData, "glBufferSubData");
+		return ok;
+	}
+
+	// Orphans target's storage, growing it to fit, and uploads data into it
+	static void StreamBuffer(GLenum target, size_t& capacity, const void* data, size_t bytes)
+	{
+		while (capacity < bytes)
+		{
+			capacity = capacity ? capacity * 2 : 64 * 1024;
+		}
+		g_buffers.BufferData(target, static_cast<std::ptrdiff_t>(capacity), nullptr, GL_STREAM_DRAW);
+		if (bytes > 0)
+		{
+			g_buffers.BufferSubData(target, 0, static_cast<std::ptrdiff_t>(bytes), data);
+		}
+	}
+
+#endif // SNOWUI_GLBATCH_ENABLED
+
+	GLBatchSubmitter::GLBatchSubmitter()
+		: glyphCache_(nullptr), atlasTexture_(0), vertexBuffer_(0), indexBuffer_(0), vertexCapacity_(0),
+		  indexCapacity_(0), created_(false)
+	{
+	}
+
+	bool GLBatchSubmitter::Create(GlyphCache* glyphCache, int width, int height)
+	{
+#ifdef SNOWUI_GLBATCH_ENABLED
+		if (!LoadBufferFunctions())
+		{
+			std::cerr << "GLBatchSubmitter: OpenGL 1.5 buffer objects not available" << std::endl;
+			return false;
+		}
+		glyphCache_ = glyphCache;
+
+		GLuint buffers[2] = {0, 0};
+		g_buffers.GenBuffers(2, buffers);
+		vertexBuffer_ = buffers[0];
+		indexBuffer_ = buffers[1];
+
+		// Alpha-only glyph atlas; GL_MODULATE multiplies it with the vertex color
+		GLuint texture = 0;
+		glGenTextures(1, &texture);
+		atlasTexture_ = texture;
+		glBindTexture(GL_TEXTURE_2D, atlasTexture_);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, glyphCache_->GetAtlasSize(), glyphCache_->GetAtlasSize(), 0, GL_ALPHA,
+		             GL_UNSIGNED_BYTE, glyphCache_->GetAtlasPixels());
+		int x, y, w, h;
+		glyphCache_->TakeDirtyRect(x, y, w, h);
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		created_ = true;
+		SetViewport(width, height);
+		return true;
+#else
+		(void)glyphCache;
+		(void)width;
+		(void)height;
+		return false;
+#endif
+	}
+
+	void GLBatchSubmitter::Destroy()
+	{
+#ifdef SNOWUI_GLBATCH_ENABLED
+		if (!created_)
+			return;
+
+		GLuint buffers[2] = {vertexBuffer_, indexBuffer_};
+		g_buffers.DeleteBuffers(2, buffers);
+		GLuint texture = atlasTexture_;
+		glDeleteTextures(1, &texture);
+#endif
+		atlasTexture_ = 0;
+		vertexBuffer_ = 0;
+		indexBuffer_ = 0;
+		vertexCapacity_ = 0;
+		indexCapacity_ = 0;
+		created_ = false;
+	}
+
+	void GLBatchSubmitter::SetViewport(int width, int height)
+	{
+#ifdef SNOWUI_GLBATCH_ENABLED
+		if (!created_)
+			return;
+
+		glViewport(0, 0, width, height);
+		glMatrixMode(GL_PROJECTION);
+		glLoadIdentity();
+		glOrtho(0, width, height, 0, -1, 1); // Top-left origin
+		glMatrixMode(GL_MODELVIEW);
+		glLoadIdentity();
+#else
+		(void)width;
+		(void)height;
+#endif
+	}
+
+	void GLBatchSubmitter::Upload(const GeometryBatcher& batcher)
+	{
+#ifdef SNOWUI_GLBATCH_ENABLED
+		if (!created_)
+			return;
+
+		int x, y, w, h;
+		if (glyphCache_->TakeDirtyRect(x, y, w, h))
+		{
+			glBindTexture(GL_TEXTURE_2D, atlasTexture_);
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, glyphCache_->GetAtlasSize());
+			glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_ALPHA, GL_UNSIGNED_BYTE,
+			                glyphCache_->GetAtlasPixels() + static_cast<size_t>(y) * glyphCache_->GetAtlasSize() + x);
+			glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		}
+
+		// Orphaning lets the driver hand out fresh storage instead of waiting
+		// for draws still reading the previous frame
+		const auto& vertices = batcher.GetVertices();
+		const auto& indices = batcher.GetIndices();
+		g_buffers.BindBuffer(GL_ARRAY_BUFFER, vertexBuffer_);
+		StreamBuffer(GL_ARRAY_BUFFER, vertexCapacity_, vertices.data(), vertices.size() * sizeof(BatchVertex));
+		g_buffers.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer_);
+		StreamBuffer(GL_ELEMENT_ARRAY_BUFFER, indexCapacity_, indices.data(), indices.size() * sizeof(uint32_t));
+		g_buffers.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		g_buffers.BindBuffer(GL_ARRAY_BUFFER, 0);
+#else
+		(void)batcher;
+#endif
+	}
+
+	void GLBatchSubmitter::Draw(const GeometryBatcher& batcher)
+	{
+#ifdef SNOWUI_GLBATCH_ENABLED
+		if (!created_)
+			return;
+
+		glEnable(GL_TEXTURE_2D);
+		glBindTexture(GL_TEXTURE_2D, atlasTexture_);
+
+		// With a buffer bound, the array pointers and index pointer are offsets
+		g_buffers.BindBuffer(GL_ARRAY_BUFFER, vertexBuffer_);
+		g_buffers.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer_);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+		glVertexPointer(2, GL_FLOAT, sizeof(BatchVertex), reinterpret_cast<const void*>(offsetof(BatchVertex, x)));
+		glTexCoordPointer(2, GL_FLOAT, sizeof(BatchVertex), reinterpret_cast<const void*>(offsetof(BatchVertex, u)));
+		glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(BatchVertex),
+		               reinterpret_cast<const void*>(offsetof(BatchVertex, r)));
+
+		for (const auto& batch : batcher.GetBatches())
+		{
+			if (batch.type == BatchType::Clear)
+			{
+				glClearColor(batch.clearColor.r, batch.clearColor.g, batch.clearColor.b, batch.clearColor.a);
+				glClear(GL_COLOR_BUFFER_BIT);
+			}
+			else if (batch.count > 0)
+			{
+				glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(batch.count), GL_UNSIGNED_INT,
+				               reinterpret_cast<const void*>(static_cast<size_t>(batch.first) * sizeof(uint32_t)));
+			}
+		}
+
+		glDisableClientState(GL_COLOR_ARRAY);
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+		g_buffers.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		g_buffers.BindBuffer(GL_ARRAY_BUFFER, 0);
+		glDisable(GL_TEXTURE_2D);
+#else
+		(void)batcher;
+#endif
+	}
+
+} // namespace SnowUI
@@ -0,0 +1,750 @@
+#include "SnowUI/Render/GLCoreBackend.h"
+#include "SnowUI/Render/GeometryBatcher.h"
+#include "SnowUI/Render/GLFWUtils.h"
+#include <iostream>
+#include <algorithm>
+#include <cstddef>
+
+#ifdef SNOWUI_GLFW_ENABLED
+#include <GLFW/glfw3.h>
+#endif
+
+#ifdef SNOWUI_OPENGL_ENABLED
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+#endif
+
+// The core renderer needs both a GL header and GLFW to resolve the
+// post-1.1 entry points; without either it compiles to a stub.
+#if defined(SNOWUI_OPENGL_ENABLED) && defined(SNOWUI_GLFW_ENABLED)
+#define SNOWUI_GLCORE_ENABLED
+#endif
+
+namespace SnowUI
+{
+
+#ifdef SNOWUI_GLCORE_ENABLED
+
+#ifdef _WIN32
+#define SNOWUI_GLAPI __stdcall
+#else
+#define SNOWUI_GLAPI
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_TRIANGLE_STRIP
+#define GL_TRIANGLE_STRIP 0x0005
+#endif
+#ifndef GL_RED
+#define GL_RED 0x1903
+#endif
+#ifndef GL_R8
+#define GL_R8 0x8229
+#endif
+#ifndef GL_UNPACK_ROW_LENGTH
+#define GL_UNPACK_ROW_LENGTH 0x0CF2
+#endif
+
+	// Entry points above GL 1.1, resolved through GLFW once a context is current
+	struct GLCoreFunctions
+	{
+		void(SNOWUI_GLAPI* GenVertexArrays)(GLsizei, GLuint*);
+		void(SNOWUI_GLAPI* DeleteVertexArrays)(GLsizei, const GLuint*);
+		void(SNOWUI_GLAPI* BindVertexArray)(GLuint);
+		void(SNOWUI_GLAPI* GenBuffers)(GLsizei, GLuint*);
+		void(SNOWUI_GLAPI* DeleteBuffers)(GLsizei, const GLuint*);
+		void(SNOWUI_GLAPI* BindBuffer)(GLenum, GLuint);
+		void(SNOWUI_GLAPI* BufferData)(GLenum, std::ptrdiff_t, const void*, GLenum);
+		void(SNOWUI_GLAPI* BufferSubData)(GLenum, std::ptrdiff_t, std::ptrdiff_t, const void*);
+		GLuint(SNOWUI_GLAPI* CreateShader)(GLenum);
+		void(SNOWUI_GLAPI* DeleteShader)(GLuint);
+		void(SNOWUI_GLAPI* ShaderSource)(GLuint, GLsizei, const char* const*, const GLint*);
+		void(SNOWUI_GLAPI* CompileShader)(GLuint);
+		void(SNOWUI_GLAPI* GetShaderiv)(GLuint, GLenum, GLint*);
+		void(SNOWUI_GLAPI* GetShaderInfoLog)(GLuint, GLsizei, GLsizei*, char*);
+		GLuint(SNOWUI_GLAPI* CreateProgram)();
+		void(SNOWUI_GLAPI* DeleteProgram)(GLuint);
+		void(SNOWUI_GLAPI* AttachShader)(GLuint, GLuint);
+		void(SNOWUI_GLAPI* LinkProgram)(GLuint);
+		void(SNOWUI_GLAPI* GetProgramiv)(GLuint, GLenum, GLint*);
+		void(SNOWUI_GLAPI* GetProgramInfoLog)(GLuint, GLsizei, GLsizei*, char*);
+		void(SNOWUI_GLAPI* UseProgram)(GLuint);
+		GLint(SNOWUI_GLAPI* GetUniformLocation)(GLuint, const char*);
+		void(SNOWUI_GLAPI* UniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*);
+		void(SNOWUI_GLAPI* Uniform1i)(GLint, GLint);
+		void(SNOWUI_GLAPI* EnableVertexAttribArray)(GLuint);
+		void(SNOWUI_GLAPI* VertexAttribPointer)(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*);
+		void(SNOWUI_GLAPI* VertexAttribDivisor)(GLuint, GLuint);
+		void(SNOWUI_GLAPI* DrawArraysInstanced)(GLenum, GLint, GLsizei, GLsizei);
+	};
+
+	static GLCoreFunctions g_gl;
+
+	template <typename T> static bool LoadProc(T& fn, const char* name)
+	{
+		fn = reinterpret_cast<T>(glfwGetProcAddress(name));
+		return fn != nullptr;
+	}
+
+	static bool LoadGLCoreFunctions()
+	{
+		bool ok = true;
+		ok &= LoadProc(g_gl.GenVertexArrays, "glGenVertexArrays");
+		ok &= LoadProc(g_gl.DeleteVertexArrays, "glDeleteVertexArrays");
+		ok &= LoadProc(g_gl.BindVertexArray, "glBindVertexArray");
+		ok &= LoadProc(g_gl.GenBuffers, "glGenBuffers");
+		ok &= LoadProc(g_gl.DeleteBuffers, "glDeleteBuffers");
+		ok &= LoadProc(g_gl.BindBuffer, "glBindBuffer");
+		ok &= LoadProc(g_gl.BufferData, "glBufferData");
+		ok &= LoadProc(g_gl.BufferSubData, "glBufferSubData");
+		ok &= LoadProc(g_gl.CreateShader, "glCreateShader");
+		ok &= LoadProc(g_gl.DeleteShader, "glDeleteShader");
+		ok &= LoadProc(g_gl.ShaderSource, "glShaderSource");
+		ok &= LoadProc(g_gl.CompileShader, "glCompileShader");
+		ok &= LoadProc(g_gl.GetShaderiv, "glGetShaderiv");
+		ok &= LoadProc(g_gl.GetShaderInfoLog, "glGetShaderInfoLog");
+		ok &= LoadProc(g_gl.CreateProgram, "glCreateProgram");
+		ok &= LoadProc(g_gl.DeleteProgram, "glDeleteProgram");
+		ok &= LoadProc(g_gl.AttachShader, "glAttachShader");
+		ok &= LoadProc(g_gl.LinkProgram, "glLinkProgram");
+		ok &= LoadProc(g_gl.GetProgramiv, "glGetProgramiv");
+		ok &= LoadProc(g_gl.GetProgramInfoLog, "glGetProgramInfoLog");
+		ok &= LoadProc(g_gl.UseProgram, "glUseProgram");
+		ok &= LoadProc(g_gl.GetUniformLocation, "glGetUniformLocation");
+		ok &= LoadProc(g_gl.UniformMatrix4fv, "glUniformMatrix4fv");
+		ok &= LoadProc(g_gl.Uniform1i, "glUniform1i");
+		ok &= LoadProc(g_gl.EnableVertexAttribArray, "glEnableVertexAttribArray");
+		ok &= LoadProc(g_gl.VertexAttribPointer, "glVertexAttribPointer");
+		ok &= LoadProc(g_gl.VertexAttribDivisor, "glVertexAttribDivisor");
+		ok &= LoadProc(g_gl.DrawArraysInstanced, "glDrawArraysInstanced");
+		return ok;
+	}
+
+	// Each instance is a unit quad drawn as a 4-vertex triangle strip. Rects
+	// interpolate between their two corners; lines are extruded along their
+	// normal by half the line width on each side.
+	static const char* kVertexShader = R"(#version 330 core
+layout(location = 0) in vec4 aGeometry;
+layout(location = 1) in vec4 aColor;
+layout(location = 2) in float aLineWidth;
+layout(location = 3) in vec4 aTexRect;
+uniform mat4 uProjection;
+out vec4 vColor;
+out vec2 vTexCoord;
+void main()
+{
+	vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+	vec2 pos;
+	if (aLineWidth > 0.0)
+	{
+		vec2 dir = aGeometry.zw - aGeometry.xy;
+		float len = length(dir);
+		vec2 normal = len > 0.0 ? vec2(-dir.y, dir.x) / len * (aLineWidth * 0.5) : vec2(0.0);
+		pos = mix(aGeometry.xy, aGeometry.zw, corner.x) + normal * (corner.y * 2.0 - 1.0);
+	}
+	else
+	{
+		pos = mix(aGeometry.xy, aGeometry.zw, corner);
+	}
+	gl_Position = uProjection * vec4(pos, 0.0, 1.0);
+	vColor = aColor;
+	vTexCoord = mix(aTexRect.xy, aTexRect.zw, corner);
+}
+)";
+
+	static const char* kFragmentShader = R"(#version 330 core
+in vec4 vColor;
+in vec2 vTexCoord;
+uniform sampler2D uAtlas;
+out vec4 fragColor;
+void main()
+{
+	fragColor = vec4(vColor.rgb, vColor.a * texture(uAtlas, vTexCoord).r);
+}
+)";
+
+	static GLuint CompileShader(GLenum type, const char* source)
+	{
+		GLuint shader = g_gl.CreateShader(type);
+		g_gl.ShaderSource(shader, 1, &source, nullptr);
+		g_gl.CompileShader(shader);
+
+		GLint status = 0;
+		g_gl.GetShaderiv(shader, GL_COMPILE_STATUS, &status);
+		if (!status)
+		{
+			char log[1024];
+			g_gl.GetShaderInfoLog(shader, sizeof(log), nullptr, log);
+			std::cerr << "GLCore Backend: Shader compilation failed: " << log << std::endl;
+			g_gl.DeleteShader(shader);
+			return 0;
+		}
+		return shader;
+	}
+
+#endif // SNOWUI_GLCORE_ENABLED
+
+	GLCoreBackend::GLCoreBackend()
+		: width_(0), height_(0), initialized_(false), eventQueue_(nullptr), window_(nullptr), ownsWindow_(false),
+		  detached_(false), offscreen_(false), program_(0), vao_(0), instanceBuffer_(0), instanceCapacity_(0),
+		  projectionLocation_(-1), atlasTexture_(0)
+	{
+		batcher_.SetGlyphCache(&glyphCache_);
+	}
+
+	GLCoreBackend::~GLCoreBackend()
+	{
+		Shutdown();
+	}
+
+	bool GLCoreBackend::CreateWindow(const std::string& title, int width, int height)
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (!InitializeGLFW())
+		{
+			std::cerr << "GLCore Backend: Failed to initialize GLFW" << std::endl;
+			return false;
+		}
+
+		// Request a 3.3 core profile context; reset first so hints left behind
+		// by other backends do not leak into this window.
+		glfwDefaultWindowHints();
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+		glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+#endif
+		if (offscreen_)
+		{
+			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		}
+
+		GLFWwindow* glfwWindow = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+		glfwDefaultWindowHints();
+		if (!glfwWindow)
+		{
+			std::cerr << "GLCore Backend: Failed to create OpenGL 3.3 core window" << std::endl;
+			TerminateGLFW();
+			return false;
+		}
+
+		glfwMakeContextCurrent(glfwWindow);
+		glfwSwapInterval(offscreen_ ? 0 : 1);
+
+		window_ = glfwWindow;
+		ownsWindow_ = true;
+		AttachGLFWEventQueue(window_, eventQueue_);
+		width_ = width;
+		height_ = height;
+
+		std::cout << "GLCore Backend: Window created (" << width << "x" << height << ")"
+				  << (offscreen_ ? " [offscreen]" : "") << std::endl;
+		return true;
+#else
+		(void)title;
+		(void)width;
+		(void)height;
+		std::cerr << "GLCore Backend: OpenGL or GLFW not available, cannot create window" << std::endl;
+		return false;
+#endif
+	}
+
+	void GLCoreBackend::DestroyWindow()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (window_ && ownsWindow_)
+		{
+			glfwDestroyWindow(static_cast<GLFWwindow*>(window_));
+			window_ = nullptr;
+			ownsWindow_ = false;
+			TerminateGLFW();
+		}
+#endif
+	}
+
+	bool GLCoreBackend::ShouldClose()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (window_)
+		{
+			return glfwWindowShouldClose(static_cast<GLFWwindow*>(window_));
+		}
+#endif
+		return true;
+	}
+
+	void GLCoreBackend::PollEvents()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		glfwPollEvents();
+#endif
+	}
+
+	bool GLCoreBackend::WaitEvents(double timeoutSeconds)
+	{
+		WaitGLFWEvents(timeoutSeconds);
+
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (window_ && !detached_)
+		{
+			// BeginFrame picks up the new size; the frame must not be skipped
+			int width, height;
+			glfwGetFramebufferSize(static_cast<GLFWwindow*>(window_), &width, &height);
+			return width != width_ || height != height_;
+		}
+#endif
+		return false;
+	}
+
+	void GLCoreBackend::SetEventQueue(EventQueue* queue)
+	{
+		eventQueue_ = queue;
+		AttachGLFWEventQueue(window_, queue);
+	}
+
+	void GLCoreBackend::PostEmptyEvent()
+	{
+		PostGLFWEmptyEvent();
+	}
+
+	void GLCoreBackend::SwapBuffers()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (window_ && !offscreen_)
+		{
+			glfwSwapBuffers(static_cast<GLFWwindow*>(window_));
+		}
+#endif
+	}
+
+	void GLCoreBackend::SetDetachedRendering(bool detached)
+	{
+		detached_ = detached;
+		MakeGLFWContextCurrent(detached ? nullptr : window_);
+	}
+
+	void GLCoreBackend::MakeContextCurrent(bool current)
+	{
+		MakeGLFWContextCurrent(current ? window_ : nullptr);
+	}
+
+	void* GLCoreBackend::GetNativeWindowHandle()
+	{
+		return window_;
+	}
+
+	bool GLCoreBackend::Initialize(int width, int height)
+	{
+		width_ = width;
+		height_ = height;
+
+		std::cout << "GLCore Backend: Initializing (" << width << "x" << height << ")" << std::endl;
+
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (window_)
+		{
+			if (!LoadGLCoreFunctions())
+			{
+				std::cerr << "GLCore Backend: OpenGL 3.3 entry points not available" << std::endl;
+				return false;
+			}
+			if (!CreatePipeline())
+			{
+				return false;
+			}
+
+			glViewport(0, 0, width, height);
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			UpdateProjection();
+		}
+#endif
+
+		initialized_ = true;
+		return true;
+	}
+
+	void GLCoreBackend::Shutdown()
+	{
+		if (!initialized_)
+			return;
+
+		std::cout << "GLCore Backend: Shutting down" << std::endl;
+
+		DestroyPipeline();
+		DestroyWindow();
+		initialized_ = false;
+	}
+
+	bool GLCoreBackend::CreatePipeline()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		GLuint vs = CompileShader(GL_VERTEX_SHADER, kVertexShader);
+		GLuint fs = CompileShader(GL_FRAGMENT_SHADER, kFragmentShader);
+		if (!vs || !fs)
+		{
+			if (vs)
+				g_gl.DeleteShader(vs);
+			if (fs)
+				g_gl.DeleteShader(fs);
+			return false;
+		}
+
+		program_ = g_gl.CreateProgram();
+		g_gl.AttachShader(program_, vs);
+		g_gl.AttachShader(program_, fs);
+		g_gl.LinkProgram(program_);
+		g_gl.DeleteShader(vs);
+		g_gl.DeleteShader(fs);
+
+		GLint status = 0;
+		g_gl.GetProgramiv(program_, GL_LINK_STATUS, &status);
+		if (!status)
+		{
+			char log[1024];
+			g_gl.GetProgramInfoLog(program_, sizeof(log), nullptr, log);
+			std::cerr << "GLCore Backend: Program link failed: " << log << std::endl;
+			g_gl.DeleteProgram(program_);
+			program_ = 0;
+			return false;
+		}
+		projectionLocation_ = g_gl.GetUniformLocation(program_, "uProjection");
+		g_gl.UseProgram(program_);
+		g_gl.Uniform1i(g_gl.GetUniformLocation(program_, "uAtlas"), 0);
+
+		GLuint texture = 0;
+		glGenTextures(1, &texture);
+		atlasTexture_ = texture;
+		glBindTexture(GL_TEXTURE_2D, atlasTexture_);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, glyphCache_.GetAtlasSize(), glyphCache_.GetAtlasSize(), 0, GL_RED,
+		             GL_UNSIGNED_BYTE, glyphCache_.GetAtlasPixels());
+		int dirtyX, dirtyY, dirtyW, dirtyH;
+		glyphCache_.TakeDirtyRect(dirtyX, dirtyY, dirtyW, dirtyH);
+
+		GLuint vao = 0;
+		GLuint buffer = 0;
+		g_gl.GenVertexArrays(1, &vao);
+		g_gl.GenBuffers(1, &buffer);
+		vao_ = vao;
+		instanceBuffer_ = buffer;
+
+		// All attributes are per-instance; the quad corner comes from gl_VertexID
+		g_gl.BindVertexArray(vao_);
+		g_gl.BindBuffer(GL_ARRAY_BUFFER, instanceBuffer_);
+		const GLsizei stride = sizeof(BatchInstance);
+		g_gl.EnableVertexAttribArray(0);
+		g_gl.VertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride,
+		                         reinterpret_cast<const void*>(offsetof(BatchInstance, x0)));
+		g_gl.VertexAttribDivisor(0, 1);
+		g_gl.EnableVertexAttribArray(1);
+		g_gl.VertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+		                         reinterpret_cast<const void*>(offsetof(BatchInstance, r)));
+		g_gl.VertexAttribDivisor(1, 1);
+		g_gl.EnableVertexAttribArray(2);
+		g_gl.VertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride,
+		                         reinterpret_cast<const void*>(offsetof(BatchInstance, lineWidth)));
+		g_gl.VertexAttribDivisor(2, 1);
+		g_gl.EnableVertexAttribArray(3);
+		g_gl.VertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride,
+		                         reinterpret_cast<const void*>(offsetof(BatchInstance, u0)));
+		g_gl.VertexAttribDivisor(3, 1);
+		g_gl.BindVertexArray(0);
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void GLCoreBackend::DestroyPipeline()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (!window_)
+			return;
+
+		if (instanceBuffer_)
+		{
+			GLuint buffer = instanceBuffer_;
+			g_gl.DeleteBuffers(1, &buffer);
+			instanceBuffer_ = 0;
+			instanceCapacity_ = 0;
+		}
+		if (vao_)
+		{
+			GLuint vao = vao_;
+			g_gl.DeleteVertexArrays(1, &vao);
+			vao_ = 0;
+		}
+		if (program_)
+		{
+			g_gl.DeleteProgram(program_);
+			program_ = 0;
+		}
+		if (atlasTexture_)
+		{
+			GLuint texture = atlasTexture_;
+			glDeleteTextures(1, &texture);
+			atlasTexture_ = 0;
+		}
+#endif
+	}
+
+	void GLCoreBackend::UpdateProjection()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (!program_)
+			return;
+
+		// Column-major orthographic projection with a top-left origin,
+		// equivalent to glOrtho(0, width, height, 0, -1, 1)
+		const float w = static_cast<float>(width_ > 0 ? width_ : 1);
+		const float h = static_cast<float>(height_ > 0 ? height_ : 1);
+		const GLfloat projection[16] = {
+			2.0f / w, 0.0f, 0.0f, 0.0f, 0.0f, -2.0f / h, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, -1.0f, 1.0f, 0.0f, 1.0f,
+		};
+		g_gl.UseProgram(program_);
+		g_gl.UniformMatrix4fv(projectionLocation_, 1, GL_FALSE, projection);
+#endif
+	}
+
+	void GLCoreBackend::BeginFrame()
+	{
+		if (!initialized_)
+			return;
+
+#ifdef SNOWUI_GLCORE_ENABLED
+		// A render thread gets new sizes through Resize()
+		if (window_ && !detached_)
+		{
+			int newWidth, newHeight;
+			glfwGetFramebufferSize(static_cast<GLFWwindow*>(window_), &newWidth, &newHeight);
+			if (newWidth != width_ || newHeight != height_)
+			{
+				Resize(newWidth, newHeight);
+			}
+		}
+#endif
+	}
+
+	void GLCoreBackend::EndFrame()
+	{
+		if (!initialized_)
+			return;
+
+		SwapBuffers();
+	}
+
+	void GLCoreBackend::ExecuteDrawList(const DrawList& drawList)
+	{
+		if (!initialized_)
+			return;
+
+		batcher_.BuildInstances(drawList);
+		if (UploadInstances())
+			DrawBatches();
+	}
+
+	void GLCoreBackend::ExecuteDrawListPartial(const DrawList& drawList, DamageRegion& damage)
+	{
+		if (!initialized_)
+			return;
+
+		batcher_.BuildInstances(drawList);
+		SubmitPartial(damage);
+	}
+
+	void GLCoreBackend::ExecuteDrawChainPartial(const DrawChain& chain, DamageRegion& damage)
+	{
+		if (!initialized_)
+			return;
+
+		batcher_.BuildInstances(chain);
+		SubmitPartial(damage);
+	}
+
+	void GLCoreBackend::SubmitPartial(DamageRegion& damage)
+	{
+		if (damage.GetWidth() != width_ || damage.GetHeight() != height_)
+		{
+			damage.Reset(width_, height_);
+			damage.AddAll();
+		}
+		damageHistory_.Accumulate(damage);
+
+		if (!UploadInstances())
+			return;
+
+		if (damage.IsFull())
+		{
+			DrawBatches();
+			return;
+		}
+
+#ifdef SNOWUI_GLCORE_ENABLED
+		// The instance buffer is uploaded once and replayed per damage rect;
+		// clears honour the scissor box as well
+		glEnable(GL_SCISSOR_TEST);
+		for (const auto& rect : damage.GetRects())
+		{
+			glScissor(rect.x, height_ - rect.Bottom(), rect.width, rect.height);
+			DrawBatches();
+		}
+		glDisable(GL_SCISSOR_TEST);
+#endif
+	}
+
+	bool GLCoreBackend::UploadInstances()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (!program_)
+			return false;
+
+		UploadAtlas();
+		g_gl.BindBuffer(GL_ARRAY_BUFFER, instanceBuffer_);
+
+		// Orphan the previous storage so the driver never stalls on a buffer
+		// the GPU is still reading, then upload the whole frame at once.
+		const auto& instances = batcher_.GetInstances();
+		size_t bytes = instances.size() * sizeof(BatchInstance);
+		while (instanceCapacity_ < bytes)
+		{
+			instanceCapacity_ = instanceCapacity_ ? instanceCapacity_ * 2 : 64 * 1024;
+		}
+		g_gl.BufferData(GL_ARRAY_BUFFER, static_cast<std::ptrdiff_t>(instanceCapacity_), nullptr, GL_STREAM_DRAW);
+		if (bytes > 0)
+		{
+			g_gl.BufferSubData(GL_ARRAY_BUFFER, 0, static_cast<std::ptrdiff_t>(bytes), instances.data());
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void GLCoreBackend::DrawBatches()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		g_gl.UseProgram(program_);
+		g_gl.BindVertexArray(vao_);
+		g_gl.BindBuffer(GL_ARRAY_BUFFER, instanceBuffer_);
+		glBindTexture(GL_TEXTURE_2D, atlasTexture_);
+
+		for (const auto& batch : batcher_.GetBatches())
+		{
+			if (batch.type == BatchType::Clear)
+			{
+				glClearColor(batch.clearColor.r, batch.clearColor.g, batch.clearColor.b, batch.clearColor.a);
+				glClear(GL_COLOR_BUFFER_BIT);
+				continue;
+			}
+			if (batch.count == 0)
+				continue;
+
+			// Attribute offsets are rebased per batch; the divisor is per-instance
+			// so the base instance is folded into the attribute pointers.
+			const GLsizei stride = sizeof(BatchInstance);
+			const size_t base = static_cast<size_t>(batch.first) * sizeof(BatchInstance);
+			g_gl.VertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride,
+			                         reinterpret_cast<const void*>(base + offsetof(BatchInstance, x0)));
+			g_gl.VertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+			                         reinterpret_cast<const void*>(base + offsetof(BatchInstance, r)));
+			g_gl.VertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride,
+			                         reinterpret_cast<const void*>(base + offsetof(BatchInstance, lineWidth)));
+			g_gl.VertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, stride,
+			                         reinterpret_cast<const void*>(base + offsetof(BatchInstance, u0)));
+			g_gl.DrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(batch.count));
+		}
+
+		g_gl.BindVertexArray(0);
+#endif
+	}
+
+	void GLCoreBackend::UploadAtlas()
+	{
+#ifdef SNOWUI_GLCORE_ENABLED
+		int x, y, w, h;
+		if (!atlasTexture_ || !glyphCache_.TakeDirtyRect(x, y, w, h))
+			return;
+
+		glBindTexture(GL_TEXTURE_2D, atlasTexture_);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, glyphCache_.GetAtlasSize());
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, GL_RED, GL_UNSIGNED_BYTE,
+		                glyphCache_.GetAtlasPixels() + static_cast<size_t>(y) * glyphCache_.GetAtlasSize() + x);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+	}
+
+	bool GLCoreBackend::ReadPixels(std::vector<uint8_t>& pixels)
+	{
+		if (!initialized_ || width_ <= 0 || height_ <= 0)
+			return false;
+
+#ifdef SNOWUI_GLCORE_ENABLED
+		if (!window_)
+			return false;
+
+		const size_t rowBytes = static_cast<size_t>(width_) * 4;
+		pixels.resize(rowBytes * static_cast<size_t>(height_));
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, width_, height_, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+		// GL returns the bottom row first; flip to top-down
+		std::vector<uint8_t> row(rowBytes);
+		for (int y = 0; y < height_ / 2; ++y)
+		{
+			uint8_t* top = pixels.data() + static_cast<size_t>(y) * rowBytes;
+			uint8_t* bottom = pixels.data() + static_cast<size_t>(height_ - 1 - y) * rowBytes;
+			std::copy(top, top + rowBytes, row.data());
+			std::copy(bottom, bottom + rowBytes, top);
+			std::copy(row.data(), row.data() + rowBytes, bottom);
+		}
+		return true;
+#else
+		(void)pixels;
+		return false;
+#endif
+	}
+
+	void GLCoreBackend::Resize(int width, int height)
+	{
+		width_ = width;
+		height_ = height;
+		damageHistory_.Reset();
+
+		if (initialized_)
+		{
+#ifdef SNOWUI_GLCORE_ENABLED
+			if (window_)
+			{
+				glViewport(0, 0, width, height);
+				UpdateProjection();
+			}
+#endif
+		}
+	}
+
+} // namespace SnowUI
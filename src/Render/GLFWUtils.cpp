@@ -1,3 +1,6 @@
+#include "SnowUI/Render/GLFWUtils.h"
+#include "SnowUI/Core/EventQueue.h"
+#include <cmath>
 #include <mutex>
 
 #ifdef SNOWUI_GLFW_ENABLED
@@ -44,4 +47,120 @@ namespace SnowUI
 #endif
 	}
 
+	void WaitGLFWEvents(double timeoutSeconds)
+	{
+#ifdef SNOWUI_GLFW_ENABLED
+		if (timeoutSeconds < 0.0)
+			glfwWaitEvents();
+		else if (timeoutSeconds == 0.0)
+			glfwPollEvents();
+		else
+			glfwWaitEventsTimeout(timeoutSeconds);
+#else
+		(void)timeoutSeconds;
+#endif
+	}
+
+#ifdef SNOWUI_GLFW_ENABLED
+	static EventQueue* GetQueue(GLFWwindow* window)
+	{
+		return static_cast<EventQueue*>(glfwGetWindowUserPointer(window));
+	}
+
+	static void SetCursorPosition(GLFWwindow* window, Event& event)
+	{
+		double x, y;
+		glfwGetCursorPos(window, &x, &y);
+		event.x = static_cast<int>(std::floor(x));
+		event.y = static_cast<int>(std::floor(y));
+	}
+
+	static void OnCursorPos(GLFWwindow* window, double x, double y)
+	{
+		Event event;
+		event.type = EventType::MouseMove;
+		event.x = static_cast<int>(std::floor(x));
+		event.y = static_cast<int>(std::floor(y));
+		GetQueue(window)->Push(event);
+	}
+
+	static void OnMouseButton(GLFWwindow* window, int button, int action, int mods)
+	{
+		Event event;
+		event.type = action == GLFW_RELEASE ? EventType::MouseUp : EventType::MouseDown;
+		event.button = button;
+		event.modifiers = mods;
+		SetCursorPosition(window, event);
+		GetQueue(window)->Push(event);
+	}
+
+	static void OnScroll(GLFWwindow* window, double xoffset, double yoffset)
+	{
+		Event event;
+		event.type = EventType::MouseWheel;
+		event.wheelX = static_cast<float>(xoffset);
+		event.wheelY = static_cast<float>(yoffset);
+		SetCursorPosition(window, event);
+		GetQueue(window)->Push(event);
+	}
+
+	static void OnKey(GLFWwindow* window, int key, int scancode, int action, int mods)
+	{
+		(void)scancode;
+		Event event;
+		event.type = action == GLFW_RELEASE ? EventType::KeyUp : EventType::KeyDown;
+		event.keyCode = key;
+		event.modifiers = mods;
+		GetQueue(window)->Push(event);
+	}
+
+	static void OnFramebufferSize(GLFWwindow* window, int width, int height)
+	{
+		Event event;
+		event.type = EventType::Resize;
+		event.width = width;
+		event.height = height;
+		GetQueue(window)->Push(event);
+	}
+#endif
+
+	void MakeGLFWContextCurrent(void* window)
+	{
+#ifdef SNOWUI_GLFW_ENABLED
+		glfwMakeContextCurrent(static_cast<GLFWwindow*>(window));
+#else
+		(void)window;
+#endif
+	}
+
+	void AttachGLFWEventQueue(void* window, EventQueue* queue)
+	{
+#ifdef SNOWUI_GLFW_ENABLED
+		if (!window)
+			return;
+
+		GLFWwindow* glfwWindow = static_cast<GLFWwindow*>(window);
+		glfwSetWindowUserPointer(glfwWindow, queue);
+		glfwSetCursorPosCallback(glfwWindow, queue ? OnCursorPos : nullptr);
+		glfwSetMouseButtonCallback(glfwWindow, queue ? OnMouseButton : nullptr);
+		glfwSetScrollCallback(glfwWindow, queue ? OnScroll : nullptr);
+		glfwSetKeyCallback(glfwWindow, queue ? OnKey : nullptr);
+		glfwSetFramebufferSizeCallback(glfwWindow, queue ? OnFramebufferSize : nullptr);
+#else
+		(void)window;
+		(void)queue;
+#endif
+	}
+
+	void PostGLFWEmptyEvent()
+	{
+#ifdef SNOWUI_GLFW_ENABLED
+		std::lock_guard<std::mutex> lock(g_glfwMutex);
+		if (g_glfwRefCount > 0)
+		{
+			glfwPostEmptyEvent();
+		}
+#endif
+	}
+
 } // namespace SnowUI
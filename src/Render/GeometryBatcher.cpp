@@ -0,0 +1,208 @@
+#include "SnowUI/Render/GeometryBatcher.h"
+#include <cmath>
+
+namespace SnowUI
+{
+
+	void GeometryBatcher::Build(const DrawList& drawList)
+	{
+		Begin<false>();
+		AddCommands<false>(drawList);
+		CloseBatch();
+	}
+
+	void GeometryBatcher::BuildInstances(const DrawList& drawList)
+	{
+		Begin<true>();
+		AddCommands<true>(drawList);
+		CloseBatch();
+	}
+
+	void GeometryBatcher::Build(const DrawChain& chain)
+	{
+		Begin<false>();
+		chain.ForEachList([this](const DrawList& drawList) { AddCommands<false>(drawList); });
+		CloseBatch();
+	}
+
+	void GeometryBatcher::BuildInstances(const DrawChain& chain)
+	{
+		Begin<true>();
+		chain.ForEachList([this](const DrawList& drawList) { AddCommands<true>(drawList); });
+		CloseBatch();
+	}
+
+	template <bool Instanced> void GeometryBatcher::Begin()
+	{
+		vertices_.clear();
+		indices_.clear();
+		instances_.clear();
+		batches_.clear();
+		instanced_ = Instanced;
+
+		whiteUV_ = 0.0f;
+		if (glyphCache_)
+		{
+			glyphCache_->BeginFrame();
+			whiteUV_ = glyphCache_->GetWhiteTexel() / glyphCache_->GetAtlasSize();
+		}
+	}
+
+	// Batches stay open across calls, so consecutive lists share them
+	template <bool Instanced> void GeometryBatcher::AddCommands(const DrawList& drawList)
+	{
+		for (const auto& cmd : drawList.GetCommands())
+		{
+			switch (cmd.type)
+			{
+			case DrawCommandType::Clear:
+			{
+				CloseBatch();
+				DrawBatch batch;
+				batch.type = BatchType::Clear;
+				batch.first = GetEmittedCount();
+				batch.count = 0;
+				batch.clearColor = cmd.color;
+				batches_.push_back(batch);
+				break;
+			}
+			case DrawCommandType::DrawRect:
+			{
+				EnsureTriangleBatch();
+				const float x1 = cmd.rect.x + cmd.rect.width;
+				const float y1 = cmd.rect.y + cmd.rect.height;
+				if constexpr (Instanced)
+					AddInstance(cmd.rect.x, cmd.rect.y, x1, y1, cmd.color, 0.0f);
+				else
+					AddQuad(cmd.rect.x, cmd.rect.y, x1, y1, cmd.color);
+				break;
+			}
+			case DrawCommandType::DrawText:
+			{
+				std::string_view text = drawList.GetText(cmd);
+				if (text.empty() || !glyphCache_)
+					break;
+
+				EnsureTriangleBatch();
+				glyphCache_->LayoutRun(text, cmd.font, cmd.fontSize, cmd.rect.x, cmd.rect.y, [&](const GlyphQuad& quad) {
+					if constexpr (Instanced)
+						AddGlyphInstance(quad, cmd.color);
+					else
+						AddGlyphQuad(quad, cmd.color);
+				});
+				break;
+			}
+			case DrawCommandType::DrawLine:
+				// rect.x, rect.y = start point; rect.width, rect.height = end point
+				EnsureTriangleBatch();
+				if constexpr (Instanced)
+					AddInstance(cmd.rect.x, cmd.rect.y, cmd.rect.width, cmd.rect.height, cmd.color, 1.0f);
+				else
+					AddLineQuad(cmd.rect.x, cmd.rect.y, cmd.rect.width, cmd.rect.height, cmd.color);
+				break;
+			}
+		}
+	}
+
+	void GeometryBatcher::AddQuad(float x0, float y0, float x1, float y1, const Color& color)
+	{
+		const float xy[8] = {x0, y0, x1, y0, x1, y1, x0, y1};
+		const float uv[8] = {whiteUV_, whiteUV_, whiteUV_, whiteUV_, whiteUV_, whiteUV_, whiteUV_, whiteUV_};
+		AddQuadVertices(xy, uv, color);
+	}
+
+	void GeometryBatcher::AddGlyphQuad(const GlyphQuad& quad, const Color& color)
+	{
+		const float scale = 1.0f / glyphCache_->GetAtlasSize();
+		const float u0 = quad.glyph->x * scale;
+		const float v0 = quad.glyph->y * scale;
+		const float u1 = (quad.glyph->x + quad.glyph->width) * scale;
+		const float v1 = (quad.glyph->y + quad.glyph->height) * scale;
+
+		const float xy[8] = {quad.x0, quad.y0, quad.x1, quad.y0, quad.x1, quad.y1, quad.x0, quad.y1};
+		const float uv[8] = {u0, v0, u1, v0, u1, v1, u0, v1};
+		AddQuadVertices(xy, uv, color);
+	}
+
+	void GeometryBatcher::AddLineQuad(float x1, float y1, float x2, float y2, const Color& color)
+	{
+		// Expand the line into a one pixel wide quad along its normal so it can
+		// share the triangle batch with rects instead of forcing a GL_LINES batch.
+		float dx = x2 - x1;
+		float dy = y2 - y1;
+		float len = std::sqrt(dx * dx + dy * dy);
+		if (len <= 0.0f)
+			return;
+
+		float nx = -dy / len * 0.5f;
+		float ny = dx / len * 0.5f;
+		const float xy[8] = {x1 + nx, y1 + ny, x2 + nx, y2 + ny, x2 - nx, y2 - ny, x1 - nx, y1 - ny};
+		const float uv[8] = {whiteUV_, whiteUV_, whiteUV_, whiteUV_, whiteUV_, whiteUV_, whiteUV_, whiteUV_};
+		AddQuadVertices(xy, uv, color);
+	}
+
+	void GeometryBatcher::AddQuadVertices(const float* xy, const float* uv, const Color& color)
+	{
+		uint32_t base = static_cast<uint32_t>(vertices_.size());
+		uint8_t r = ColorToByte(color.r);
+		uint8_t g = ColorToByte(color.g);
+		uint8_t b = ColorToByte(color.b);
+		uint8_t a = ColorToByte(color.a);
+
+		for (int i = 0; i < 4; ++i)
+		{
+			vertices_.push_back(BatchVertex{xy[i * 2], xy[i * 2 + 1], uv[i * 2], uv[i * 2 + 1], r, g, b, a});
+		}
+
+		const uint32_t quad[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+		indices_.insert(indices_.end(), quad, quad + 6);
+	}
+
+	void GeometryBatcher::AddInstance(float x0, float y0, float x1, float y1, const Color& color, float lineWidth)
+	{
+		instances_.push_back(BatchInstance{x0, y0, x1, y1, whiteUV_, whiteUV_, whiteUV_, whiteUV_,
+		                                   ColorToByte(color.r), ColorToByte(color.g), ColorToByte(color.b),
+		                                   ColorToByte(color.a), lineWidth});
+	}
+
+	void GeometryBatcher::AddGlyphInstance(const GlyphQuad& quad, const Color& color)
+	{
+		const float scale = 1.0f / glyphCache_->GetAtlasSize();
+		AddInstance(quad.x0, quad.y0, quad.x1, quad.y1, color, 0.0f);
+		BatchInstance& instance = instances_.back();
+		instance.u0 = quad.glyph->x * scale;
+		instance.v0 = quad.glyph->y * scale;
+		instance.u1 = (quad.glyph->x + quad.glyph->width) * scale;
+		instance.v1 = (quad.glyph->y + quad.glyph->height) * scale;
+	}
+
+	uint32_t GeometryBatcher::GetEmittedCount() const
+	{
+		return static_cast<uint32_t>(instanced_ ? instances_.size() : indices_.size());
+	}
+
+	void GeometryBatcher::EnsureTriangleBatch()
+	{
+		if (!batches_.empty() && batches_.back().type == BatchType::Triangles)
+			return;
+
+		DrawBatch batch;
+		batch.type = BatchType::Triangles;
+		batch.first = GetEmittedCount();
+		batch.count = 0;
+		batches_.push_back(batch);
+	}
+
+	void GeometryBatcher::CloseBatch()
+	{
+		if (batches_.empty())
+			return;
+
+		DrawBatch& batch = batches_.back();
+		if (batch.type == BatchType::Triangles)
+		{
+			batch.count = GetEmittedCount() - batch.first;
+		}
+	}
+
+} // namespace SnowUI
@@ -0,0 +1,261 @@
+#include "SnowUI/Render/GlyphCache.h"
+#include <algorithm>
+
+namespace SnowUI
+{
+
+	// Texels left empty around each glyph so filtering never bleeds neighbours
+	static constexpr int kGlyphPadding = 1;
+
+	// Reserved rows at the top of the atlas holding the 2x2 white block
+	static constexpr int kReservedRows = 2 + kGlyphPadding;
+
+	static uint64_t MakeKey(FontId font, uint16_t size, uint32_t codepoint)
+	{
+		return (static_cast<uint64_t>(font) << 48) | (static_cast<uint64_t>(size) << 32) | codepoint;
+	}
+
+	// Shelf heights are rounded up so glyphs of similar size share shelves
+	static int ShelfHeightFor(int height)
+	{
+		return (height + 7) & ~7;
+	}
+
+	GlyphCache::GlyphCache(int atlasSize)
+		: atlasSize_(std::max(atlasSize, 16)), nextShelfY_(kReservedRows), frame_(0), fontGeneration_(0),
+		  dirtyX0_(0), dirtyY0_(0), dirtyX1_(0), dirtyY1_(0)
+	{
+		overflowGlyph_ = CachedGlyph{0, 0, 0, 0, 0, 0, 0.0f};
+		Clear();
+	}
+
+	void GlyphCache::Clear()
+	{
+		pixels_.assign(static_cast<size_t>(atlasSize_) * atlasSize_, 0);
+		for (int y = 0; y < 2; ++y)
+		{
+			pixels_[static_cast<size_t>(y) * atlasSize_] = 255;
+			pixels_[static_cast<size_t>(y) * atlasSize_ + 1] = 255;
+		}
+
+		shelves_.clear();
+		freeSlots_.clear();
+		nextShelfY_ = kReservedRows;
+		entries_.clear();
+		lru_.clear();
+		fontGeneration_ = FontRegistry::Instance().GetGeneration();
+
+		stats_.glyphCount = 0;
+		stats_.usedTexels = 0;
+		stats_.atlasTexels = static_cast<size_t>(atlasSize_) * atlasSize_;
+		MarkDirty(0, 0, atlasSize_, atlasSize_);
+	}
+
+	void GlyphCache::BeginFrame()
+	{
+		frame_++;
+		if (FontRegistry::Instance().GetGeneration() != fontGeneration_)
+		{
+			Clear();
+		}
+	}
+
+	void GlyphCache::ResetCounters()
+	{
+		stats_.hits = 0;
+		stats_.misses = 0;
+		stats_.evictions = 0;
+		stats_.overflows = 0;
+	}
+
+	const CachedGlyph& GlyphCache::GetGlyph(FontId font, uint16_t size, uint32_t codepoint)
+	{
+		const uint64_t key = MakeKey(font, size, codepoint);
+		auto it = entries_.find(key);
+		if (it != entries_.end())
+		{
+			stats_.hits++;
+			Entry& entry = it->second;
+			entry.lastFrame = frame_;
+			lru_.splice(lru_.begin(), lru_, entry.lru);
+			return entry.glyph;
+		}
+
+		stats_.misses++;
+		if (!FontRegistry::Instance().RasterizeGlyph(font, size, codepoint, scratch_))
+		{
+			// Unknown glyph: cache an empty one so the miss is not repeated
+			scratch_.width = 0;
+			scratch_.height = 0;
+			scratch_.bearingX = 0;
+			scratch_.bearingY = 0;
+			scratch_.advance = 0.0f;
+		}
+
+		Entry entry;
+		entry.glyph.x = 0;
+		entry.glyph.y = 0;
+		entry.glyph.width = static_cast<uint16_t>(scratch_.width);
+		entry.glyph.height = static_cast<uint16_t>(scratch_.height);
+		entry.glyph.bearingX = static_cast<int16_t>(scratch_.bearingX);
+		entry.glyph.bearingY = static_cast<int16_t>(scratch_.bearingY);
+		entry.glyph.advance = scratch_.advance;
+		entry.slot = Slot{0, 0, 0, 0};
+		entry.hasSlot = false;
+		entry.lastFrame = frame_;
+
+		if (scratch_.width > 0 && scratch_.height > 0)
+		{
+			if (!Allocate(scratch_.width + kGlyphPadding, scratch_.height + kGlyphPadding, entry.slot))
+			{
+				stats_.overflows++;
+				overflowGlyph_.advance = scratch_.advance;
+				return overflowGlyph_;
+			}
+
+			entry.hasSlot = true;
+			entry.glyph.x = entry.slot.x;
+			entry.glyph.y = entry.slot.y;
+			for (int y = 0; y < scratch_.height; ++y)
+			{
+				const uint8_t* src = scratch_.coverage.data() + static_cast<size_t>(y) * scratch_.width;
+				uint8_t* dst = pixels_.data() + static_cast<size_t>(entry.slot.y + y) * atlasSize_ + entry.slot.x;
+				std::copy(src, src + scratch_.width, dst);
+			}
+			MarkDirty(entry.slot.x, entry.slot.y, scratch_.width, scratch_.height);
+			stats_.usedTexels += static_cast<size_t>(entry.slot.width) * entry.slot.height;
+		}
+
+		lru_.push_front(key);
+		entry.lru = lru_.begin();
+		auto inserted = entries_.emplace(key, entry).first;
+		stats_.glyphCount = entries_.size();
+		return inserted->second.glyph;
+	}
+
+	bool GlyphCache::Allocate(int width, int height, Slot& slot)
+	{
+		if (width > atlasSize_ || height > atlasSize_ - kReservedRows)
+			return false;
+
+		for (;;)
+		{
+			// Smallest freed slot that fits wins; it is reused whole
+			auto best = freeSlots_.end();
+			for (auto it = freeSlots_.begin(); it != freeSlots_.end(); ++it)
+			{
+				if (it->width >= width && it->height >= height &&
+				    (best == freeSlots_.end() || it->width * it->height < best->width * best->height))
+				{
+					best = it;
+				}
+			}
+			if (best != freeSlots_.end())
+			{
+				slot = *best;
+				*best = freeSlots_.back();
+				freeSlots_.pop_back();
+				return true;
+			}
+
+			if (AllocateFresh(width, height, slot))
+				return true;
+
+			if (!EvictOne())
+				return false;
+		}
+	}
+
+	bool GlyphCache::AllocateFresh(int width, int height, Slot& slot)
+	{
+		const int shelfHeight = ShelfHeightFor(height);
+
+		for (auto& shelf : shelves_)
+		{
+			if (shelf.height == shelfHeight && shelf.nextX + width <= atlasSize_)
+			{
+				slot = Slot{static_cast<uint16_t>(shelf.nextX), static_cast<uint16_t>(shelf.y),
+				            static_cast<uint16_t>(width), static_cast<uint16_t>(shelfHeight)};
+				shelf.nextX += width;
+				return true;
+			}
+		}
+
+		if (nextShelfY_ + shelfHeight > atlasSize_)
+			return false;
+
+		Shelf shelf;
+		shelf.y = nextShelfY_;
+		shelf.height = shelfHeight;
+		shelf.nextX = width;
+		shelves_.push_back(shelf);
+		nextShelfY_ += shelfHeight;
+
+		slot = Slot{0, static_cast<uint16_t>(shelf.y), static_cast<uint16_t>(width), static_cast<uint16_t>(shelfHeight)};
+		return true;
+	}
+
+	bool GlyphCache::EvictOne()
+	{
+		// Walk from the least recently used end, skipping glyphs without atlas
+		// space; anything used this frame (and everything newer) is pinned
+		for (auto it = lru_.end(); it != lru_.begin();)
+		{
+			--it;
+			auto entryIt = entries_.find(*it);
+			Entry& entry = entryIt->second;
+			if (entry.lastFrame == frame_)
+				return false;
+			if (!entry.hasSlot)
+				continue;
+
+			const Slot& slot = entry.slot;
+			for (int y = 0; y < slot.height; ++y)
+			{
+				uint8_t* row = pixels_.data() + static_cast<size_t>(slot.y + y) * atlasSize_ + slot.x;
+				std::fill(row, row + slot.width, static_cast<uint8_t>(0));
+			}
+			MarkDirty(slot.x, slot.y, slot.width, slot.height);
+
+			freeSlots_.push_back(slot);
+			stats_.usedTexels -= static_cast<size_t>(slot.width) * slot.height;
+			stats_.evictions++;
+			lru_.erase(it);
+			entries_.erase(entryIt);
+			stats_.glyphCount = entries_.size();
+			return true;
+		}
+		return false;
+	}
+
+	void GlyphCache::MarkDirty(int x, int y, int width, int height)
+	{
+		if (dirtyX1_ <= dirtyX0_ || dirtyY1_ <= dirtyY0_)
+		{
+			dirtyX0_ = x;
+			dirtyY0_ = y;
+			dirtyX1_ = x + width;
+			dirtyY1_ = y + height;
+			return;
+		}
+
+		dirtyX0_ = std::min(dirtyX0_, x);
+		dirtyY0_ = std::min(dirtyY0_, y);
+		dirtyX1_ = std::max(dirtyX1_, x + width);
+		dirtyY1_ = std::max(dirtyY1_, y + height);
+	}
+
+	bool GlyphCache::TakeDirtyRect(int& x, int& y, int& width, int& height)
+	{
+		if (dirtyX1_ <= dirtyX0_ || dirtyY1_ <= dirtyY0_)
+			return false;
+
+		x = dirtyX0_;
+		y = dirtyY0_;
+		width = dirtyX1_ - dirtyX0_;
+		height = dirtyY1_ - dirtyY0_;
+		dirtyX0_ = dirtyY0_ = dirtyX1_ = dirtyY1_ = 0;
+		return true;
+	}
+
+} // namespace SnowUI
@@ -18,12 +18,11 @@
 namespace SnowUI
 {
 
-	// Text rendering constants (placeholder for real font system)
-	static constexpr float kDefaultCharWidth = 7.0f;
-	static constexpr float kDefaultCharHeight = 12.0f;
-
-	OpenGLBackend::OpenGLBackend() : width_(0), height_(0), initialized_(false), window_(nullptr), ownsWindow_(false)
+	OpenGLBackend::OpenGLBackend()
+		: width_(0), height_(0), initialized_(false), eventQueue_(nullptr), window_(nullptr), ownsWindow_(false),
+		  detached_(false)
 	{
+		batcher_.SetGlyphCache(&glyphCache_);
 	}
 
 	OpenGLBackend::~OpenGLBackend()
@@ -57,6 +56,7 @@ namespace SnowUI
 
 		window_ = glfwWindow;
 		ownsWindow_ = true;
+		AttachGLFWEventQueue(window_, eventQueue_);
 		width_ = width;
 		height_ = height;
 
@@ -102,6 +102,33 @@ namespace SnowUI
 #endif
 	}
 
+	bool OpenGLBackend::WaitEvents(double timeoutSeconds)
+	{
+		WaitGLFWEvents(timeoutSeconds);
+
+#ifdef SNOWUI_GLFW_ENABLED
+		if (window_ && !detached_)
+		{
+			// BeginFrame picks up the new size; the frame must not be skipped
+			int width, height;
+			glfwGetFramebufferSize(static_cast<GLFWwindow*>(window_), &width, &height);
+			return width != width_ || height != height_;
+		}
+#endif
+		return false;
+	}
+
+	void OpenGLBackend::SetEventQueue(EventQueue* queue)
+	{
+		eventQueue_ = queue;
+		AttachGLFWEventQueue(window_, queue);
+	}
+
+	void OpenGLBackend::PostEmptyEvent()
+	{
+		PostGLFWEmptyEvent();
+	}
+
 	void OpenGLBackend::SwapBuffers()
 	{
 #ifdef SNOWUI_GLFW_ENABLED
@@ -112,6 +139,17 @@ namespace SnowUI
 #endif
 	}
 
+	void OpenGLBackend::SetDetachedRendering(bool detached)
+	{
+		detached_ = detached;
+		MakeGLFWContextCurrent(detached ? nullptr : window_);
+	}
+
+	void OpenGLBackend::MakeContextCurrent(bool current)
+	{
+		MakeGLFWContextCurrent(current ? window_ : nullptr);
+	}
+
 	void* OpenGLBackend::GetNativeWindowHandle()
 	{
 		return window_;
@@ -124,25 +162,11 @@ namespace SnowUI
 
 		std::cout << "OpenGL Backend: Initializing (" << width << "x" << height << ")" << std::endl;
 
-#ifdef SNOWUI_OPENGL_ENABLED
-		// If we have a window context, set up the viewport
+		// Fixed-function state, atlas and buffers need the window's context
 		if (window_)
 		{
-			glViewport(0, 0, width, height);
-
-			// Set up orthographic projection for 2D rendering
-			glMatrixMode(GL_PROJECTION);
-			glLoadIdentity();
-			glOrtho(0, width, height, 0, -1, 1); // Top-left origin
-
-			glMatrixMode(GL_MODELVIEW);
-			glLoadIdentity();
-
-			// Enable blending for transparency
-			glEnable(GL_BLEND);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			submitter_.Create(&glyphCache_, width, height);
 		}
-#endif
 
 		initialized_ = true;
 		return true;
@@ -155,6 +179,10 @@ namespace SnowUI
 
 		std::cout << "OpenGL Backend: Shutting down" << std::endl;
 
+		if (window_)
+		{
+			submitter_.Destroy();
+		}
 		DestroyWindow();
 		initialized_ = false;
 	}
@@ -165,8 +193,8 @@ namespace SnowUI
 			return;
 
 #ifdef SNOWUI_OPENGL_ENABLED
-		// Check for window resize
-		if (window_)
+		// Check for window resize; a render thread gets it through Resize()
+		if (window_ && !detached_)
 		{
 #ifdef SNOWUI_GLFW_ENABLED
 			int newWidth, newHeight;
@@ -188,133 +216,71 @@ namespace SnowUI
 		SwapBuffers();
 	}
 
-	void OpenGLBackend::ClearScreen(const Color& color)
+	void OpenGLBackend::ExecuteDrawList(const DrawList& drawList)
 	{
-#ifdef SNOWUI_OPENGL_ENABLED
-		glClearColor(color.r, color.g, color.b, color.a);
-		glClear(GL_COLOR_BUFFER_BIT);
-#else
-		(void)color;
-#endif
-	}
+		if (!initialized_)
+			return;
 
-	void OpenGLBackend::DrawRect(const Rect& rect, const Color& color)
-	{
-#ifdef SNOWUI_OPENGL_ENABLED
-		glColor4f(color.r, color.g, color.b, color.a);
-		glBegin(GL_QUADS);
-		glVertex2f(rect.x, rect.y);
-		glVertex2f(rect.x + rect.width, rect.y);
-		glVertex2f(rect.x + rect.width, rect.y + rect.height);
-		glVertex2f(rect.x, rect.y + rect.height);
-		glEnd();
-#else
-		(void)rect;
-		(void)color;
-#endif
+		batcher_.Build(drawList);
+		submitter_.Upload(batcher_);
+		submitter_.Draw(batcher_);
 	}
 
-	void OpenGLBackend::DrawLine(float x1, float y1, float x2, float y2, const Color& color)
+	void OpenGLBackend::ExecuteDrawListPartial(const DrawList& drawList, DamageRegion& damage)
 	{
-#ifdef SNOWUI_OPENGL_ENABLED
-		glColor4f(color.r, color.g, color.b, color.a);
-		glBegin(GL_LINES);
-		glVertex2f(x1, y1);
-		glVertex2f(x2, y2);
-		glEnd();
-#else
-		(void)x1;
-		(void)y1;
-		(void)x2;
-		(void)y2;
-		(void)color;
-#endif
+		if (!initialized_)
+			return;
+
+		batcher_.Build(drawList);
+		SubmitPartial(damage);
 	}
 
-	void OpenGLBackend::DrawText(const std::string& text, float x, float y, const Color& color)
+	void OpenGLBackend::ExecuteDrawChainPartial(const DrawChain& chain, DamageRegion& damage)
 	{
-		// Basic text rendering using simple rectangles for each character
-		// In a real implementation, this would use font rendering with textures
-#ifdef SNOWUI_OPENGL_ENABLED
-		if (text.empty())
+		if (!initialized_)
 			return;
 
-		// Draw a simple text indicator (a colored rectangle per character)
-		float curX = x;
-		for (size_t i = 0; i < text.length(); ++i)
-		{
-			char c = text[i];
-			if (c == ' ')
-			{
-				curX += kDefaultCharWidth;
-				continue;
-			}
-
-			// Draw character as small filled rectangle (placeholder for real font rendering)
-			glColor4f(color.r, color.g, color.b, color.a);
-			glBegin(GL_QUADS);
-			glVertex2f(curX, y);
-			glVertex2f(curX + kDefaultCharWidth - 1, y);
-			glVertex2f(curX + kDefaultCharWidth - 1, y + kDefaultCharHeight);
-			glVertex2f(curX, y + kDefaultCharHeight);
-			glEnd();
-
-			curX += kDefaultCharWidth;
-		}
-#else
-		(void)text;
-		(void)x;
-		(void)y;
-		(void)color;
-#endif
+		batcher_.Build(chain);
+		SubmitPartial(damage);
 	}
 
-	void OpenGLBackend::ExecuteDrawList(const DrawList& drawList)
+	void OpenGLBackend::SubmitPartial(DamageRegion& damage)
 	{
-		if (!initialized_)
-			return;
+		if (damage.GetWidth() != width_ || damage.GetHeight() != height_)
+		{
+			damage.Reset(width_, height_);
+			damage.AddAll();
+		}
+		damageHistory_.Accumulate(damage);
 
-		const auto& commands = drawList.GetCommands();
+		submitter_.Upload(batcher_);
+		if (damage.IsFull() || !submitter_.IsCreated())
+		{
+			submitter_.Draw(batcher_);
+			return;
+		}
 
-		for (const auto& cmd : commands)
+#ifdef SNOWUI_OPENGL_ENABLED
+		// Clears honour the scissor box too, so each rect is a complete redraw
+		glEnable(GL_SCISSOR_TEST);
+		for (const auto& rect : damage.GetRects())
 		{
-			switch (cmd.type)
-			{
-			case DrawCommandType::Clear:
-				ClearScreen(cmd.color);
-				break;
-			case DrawCommandType::DrawRect:
-				DrawRect(cmd.rect, cmd.color);
-				break;
-			case DrawCommandType::DrawText:
-				DrawText(cmd.text, cmd.rect.x, cmd.rect.y, cmd.color);
-				break;
-			case DrawCommandType::DrawLine:
-				// rect.x, rect.y = start point; rect.width, rect.height = end point
-				DrawLine(cmd.rect.x, cmd.rect.y, cmd.rect.width, cmd.rect.height, cmd.color);
-				break;
-			}
+			glScissor(rect.x, height_ - rect.Bottom(), rect.width, rect.height);
+			submitter_.Draw(batcher_);
 		}
+		glDisable(GL_SCISSOR_TEST);
+#endif
 	}
 
 	void OpenGLBackend::Resize(int width, int height)
 	{
 		width_ = width;
 		height_ = height;
+		damageHistory_.Reset();
 
 		if (initialized_)
 		{
-#ifdef SNOWUI_OPENGL_ENABLED
-			glViewport(0, 0, width, height);
-
-			// Update orthographic projection
-			glMatrixMode(GL_PROJECTION);
-			glLoadIdentity();
-			glOrtho(0, width, height, 0, -1, 1);
-
-			glMatrixMode(GL_MODELVIEW);
-			glLoadIdentity();
-#endif
+			submitter_.SetViewport(width, height);
 		}
 	}
 
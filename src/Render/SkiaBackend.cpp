@@ -23,12 +23,11 @@
 namespace SnowUI
 {
 
-	// Text rendering constants (placeholder for real font system)
-	static constexpr float kDefaultCharWidth = 7.0f;
-	static constexpr float kDefaultCharHeight = 12.0f;
-
-	SkiaBackend::SkiaBackend() : width_(0), height_(0), initialized_(false), window_(nullptr), ownsWindow_(false)
+	SkiaBackend::SkiaBackend()
+		: width_(0), height_(0), initialized_(false), eventQueue_(nullptr), window_(nullptr), ownsWindow_(false),
+		  detached_(false)
 	{
+		batcher_.SetGlyphCache(&glyphCache_);
 	}
 
 	SkiaBackend::~SkiaBackend()
@@ -62,6 +61,7 @@ namespace SnowUI
 
 		window_ = glfwWindow;
 		ownsWindow_ = true;
+		AttachGLFWEventQueue(window_, eventQueue_);
 		width_ = width;
 		height_ = height;
 
@@ -108,6 +108,33 @@ namespace SnowUI
 #endif
 	}
 
+	bool SkiaBackend::WaitEvents(double timeoutSeconds)
+	{
+		WaitGLFWEvents(timeoutSeconds);
+
+#ifdef SNOWUI_GLFW_ENABLED
+		if (window_ && !detached_)
+		{
+			// BeginFrame picks up the new size; the frame must not be skipped
+			int width, height;
+			glfwGetFramebufferSize(static_cast<GLFWwindow*>(window_), &width, &height);
+			return width != width_ || height != height_;
+		}
+#endif
+		return false;
+	}
+
+	void SkiaBackend::SetEventQueue(EventQueue* queue)
+	{
+		eventQueue_ = queue;
+		AttachGLFWEventQueue(window_, queue);
+	}
+
+	void SkiaBackend::PostEmptyEvent()
+	{
+		PostGLFWEmptyEvent();
+	}
+
 	void SkiaBackend::SwapBuffers()
 	{
 #ifdef SNOWUI_GLFW_ENABLED
@@ -118,6 +145,17 @@ namespace SnowUI
 #endif
 	}
 
+	void SkiaBackend::SetDetachedRendering(bool detached)
+	{
+		detached_ = detached;
+		MakeGLFWContextCurrent(detached ? nullptr : window_);
+	}
+
+	void SkiaBackend::MakeContextCurrent(bool current)
+	{
+		MakeGLFWContextCurrent(current ? window_ : nullptr);
+	}
+
 	void* SkiaBackend::GetNativeWindowHandle()
 	{
 		return window_;
@@ -130,22 +168,11 @@ namespace SnowUI
 
 		std::cout << "Skia Backend: Initializing (" << width << "x" << height << ")" << std::endl;
 
-#ifdef SNOWUI_OPENGL_ENABLED
+		// Fixed-function state, atlas and buffers need the window's context
 		if (window_)
 		{
-			glViewport(0, 0, width, height);
-
-			glMatrixMode(GL_PROJECTION);
-			glLoadIdentity();
-			glOrtho(0, width, height, 0, -1, 1);
-
-			glMatrixMode(GL_MODELVIEW);
-			glLoadIdentity();
-
-			glEnable(GL_BLEND);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			submitter_.Create(&glyphCache_, width, height);
 		}
-#endif
 
 		initialized_ = true;
 		return true;
@@ -158,6 +185,10 @@ namespace SnowUI
 
 		std::cout << "Skia Backend: Shutting down" << std::endl;
 
+		if (window_)
+		{
+			submitter_.Destroy();
+		}
 		DestroyWindow();
 		initialized_ = false;
 	}
@@ -168,7 +199,8 @@ namespace SnowUI
 			return;
 
 #ifdef SNOWUI_OPENGL_ENABLED
-		if (window_)
+		// A render thread gets new sizes through Resize()
+		if (window_ && !detached_)
 		{
 #ifdef SNOWUI_GLFW_ENABLED
 			int newWidth, newHeight;
@@ -190,127 +222,71 @@ namespace SnowUI
 		SwapBuffers();
 	}
 
-	void SkiaBackend::ClearScreen(const Color& color)
+	void SkiaBackend::ExecuteDrawList(const DrawList& drawList)
 	{
-#ifdef SNOWUI_OPENGL_ENABLED
-		glClearColor(color.r, color.g, color.b, color.a);
-		glClear(GL_COLOR_BUFFER_BIT);
-#else
-		(void)color;
-#endif
-	}
+		if (!initialized_)
+			return;
 
-	void SkiaBackend::DrawRect(const Rect& rect, const Color& color)
-	{
-#ifdef SNOWUI_OPENGL_ENABLED
-		glColor4f(color.r, color.g, color.b, color.a);
-		glBegin(GL_QUADS);
-		glVertex2f(rect.x, rect.y);
-		glVertex2f(rect.x + rect.width, rect.y);
-		glVertex2f(rect.x + rect.width, rect.y + rect.height);
-		glVertex2f(rect.x, rect.y + rect.height);
-		glEnd();
-#else
-		(void)rect;
-		(void)color;
-#endif
+		batcher_.Build(drawList);
+		submitter_.Upload(batcher_);
+		submitter_.Draw(batcher_);
 	}
 
-	void SkiaBackend::DrawLine(float x1, float y1, float x2, float y2, const Color& color)
+	void SkiaBackend::ExecuteDrawListPartial(const DrawList& drawList, DamageRegion& damage)
 	{
-#ifdef SNOWUI_OPENGL_ENABLED
-		glColor4f(color.r, color.g, color.b, color.a);
-		glBegin(GL_LINES);
-		glVertex2f(x1, y1);
-		glVertex2f(x2, y2);
-		glEnd();
-#else
-		(void)x1;
-		(void)y1;
-		(void)x2;
-		(void)y2;
-		(void)color;
-#endif
+		if (!initialized_)
+			return;
+
+		batcher_.Build(drawList);
+		SubmitPartial(damage);
 	}
 
-	void SkiaBackend::DrawText(const std::string& text, float x, float y, const Color& color)
+	void SkiaBackend::ExecuteDrawChainPartial(const DrawChain& chain, DamageRegion& damage)
 	{
-#ifdef SNOWUI_OPENGL_ENABLED
-		if (text.empty())
+		if (!initialized_)
 			return;
 
-		float curX = x;
-		for (size_t i = 0; i < text.length(); ++i)
-		{
-			char c = text[i];
-			if (c == ' ')
-			{
-				curX += kDefaultCharWidth;
-				continue;
-			}
-
-			glColor4f(color.r, color.g, color.b, color.a);
-			glBegin(GL_QUADS);
-			glVertex2f(curX, y);
-			glVertex2f(curX + kDefaultCharWidth - 1, y);
-			glVertex2f(curX + kDefaultCharWidth - 1, y + kDefaultCharHeight);
-			glVertex2f(curX, y + kDefaultCharHeight);
-			glEnd();
-
-			curX += kDefaultCharWidth;
-		}
-#else
-		(void)text;
-		(void)x;
-		(void)y;
-		(void)color;
-#endif
+		batcher_.Build(chain);
+		SubmitPartial(damage);
 	}
 
-	void SkiaBackend::ExecuteDrawList(const DrawList& drawList)
+	void SkiaBackend::SubmitPartial(DamageRegion& damage)
 	{
-		if (!initialized_)
-			return;
+		if (damage.GetWidth() != width_ || damage.GetHeight() != height_)
+		{
+			damage.Reset(width_, height_);
+			damage.AddAll();
+		}
+		damageHistory_.Accumulate(damage);
 
-		const auto& commands = drawList.GetCommands();
+		submitter_.Upload(batcher_);
+		if (damage.IsFull() || !submitter_.IsCreated())
+		{
+			submitter_.Draw(batcher_);
+			return;
+		}
 
-		for (const auto& cmd : commands)
+#ifdef SNOWUI_OPENGL_ENABLED
+		// Clears honour the scissor box too, so each rect is a complete redraw
+		glEnable(GL_SCISSOR_TEST);
+		for (const auto& rect : damage.GetRects())
 		{
-			switch (cmd.type)
-			{
-			case DrawCommandType::Clear:
-				ClearScreen(cmd.color);
-				break;
-			case DrawCommandType::DrawRect:
-				DrawRect(cmd.rect, cmd.color);
-				break;
-			case DrawCommandType::DrawText:
-				DrawText(cmd.text, cmd.rect.x, cmd.rect.y, cmd.color);
-				break;
-			case DrawCommandType::DrawLine:
-				DrawLine(cmd.rect.x, cmd.rect.y, cmd.rect.width, cmd.rect.height, cmd.color);
-				break;
-			}
+			glScissor(rect.x, height_ - rect.Bottom(), rect.width, rect.height);
+			submitter_.Draw(batcher_);
 		}
+		glDisable(GL_SCISSOR_TEST);
+#endif
 	}
 
 	void SkiaBackend::Resize(int width, int height)
 	{
 		width_ = width;
 		height_ = height;
+		damageHistory_.Reset();
 
 		if (initialized_)
 		{
-#ifdef SNOWUI_OPENGL_ENABLED
-			glViewport(0, 0, width, height);
-
-			glMatrixMode(GL_PROJECTION);
-			glLoadIdentity();
-			glOrtho(0, width, height, 0, -1, 1);
-
-			glMatrixMode(GL_MODELVIEW);
-			glLoadIdentity();
-#endif
+			submitter_.SetViewport(width, height);
 		}
 	}
 
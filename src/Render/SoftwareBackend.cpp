@@ -0,0 +1,415 @@
+#include "SnowUI/Render/SoftwareBackend.h"
+#include "SnowUI/Render/GeometryBatcher.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace SnowUI
+{
+
+	// Packs four bytes so that they land in memory as R, G, B, A
+	static uint32_t PackRGBA(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+	{
+		const uint8_t bytes[4] = {r, g, b, a};
+		uint32_t packed;
+		std::memcpy(&packed, bytes, sizeof(packed));
+		return packed;
+	}
+
+	SoftwareBackend::SoftwareBackend(int threadCount)
+		: width_(0), height_(0), initialized_(false), threadCount_(threadCount), kernels_(&GetBlendKernels()),
+		  tilesX_(0), tilesY_(0), fullRedrawPending_(true)
+	{
+	}
+
+	SoftwareBackend::~SoftwareBackend()
+	{
+		Shutdown();
+	}
+
+	bool SoftwareBackend::Initialize(int width, int height)
+	{
+		std::cout << "Software Backend: Initializing (" << width << "x" << height << ")" << std::endl;
+
+		if (!pool_)
+		{
+			pool_.reset(new ThreadPool(threadCount_ > 0 ? threadCount_ - 1 : -1));
+		}
+
+		initialized_ = true;
+		Resize(width, height);
+
+		std::cout << "Software Backend: Rasterizing on " << pool_->GetConcurrency() << " thread(s) using "
+				  << GetBlendISAName(kernels_->isa) << " kernels" << std::endl;
+		return true;
+	}
+
+	void SoftwareBackend::Shutdown()
+	{
+		if (!initialized_)
+			return;
+
+		std::cout << "Software Backend: Shutting down" << std::endl;
+
+		pool_.reset();
+		framebuffer_.clear();
+		framebuffer_.shrink_to_fit();
+		initialized_ = false;
+	}
+
+	void SoftwareBackend::BeginFrame()
+	{
+	}
+
+	void SoftwareBackend::EndFrame()
+	{
+	}
+
+	void SoftwareBackend::Resize(int width, int height)
+	{
+		width_ = std::max(width, 0);
+		height_ = std::max(height, 0);
+
+		if (!initialized_)
+			return;
+
+		framebuffer_.assign(static_cast<size_t>(width_) * static_cast<size_t>(height_), PackRGBA(0, 0, 0, 255));
+		tilesX_ = (width_ + kTileSize - 1) / kTileSize;
+		tilesY_ = (height_ + kTileSize - 1) / kTileSize;
+		tileBins_.resize(static_cast<size_t>(tilesX_) * static_cast<size_t>(tilesY_));
+		fullRedrawPending_ = true;
+	}
+
+	void SoftwareBackend::ExecuteDrawList(const DrawList& drawList)
+	{
+		if (!initialized_ || framebuffer_.empty())
+			return;
+
+		clipRects_.assign(1, DamageRect{0, 0, width_, height_});
+		BeginPrimitives();
+		BuildPrimitives(drawList);
+		BinPrimitives();
+		Rasterize();
+		fullRedrawPending_ = false;
+	}
+
+	bool SoftwareBackend::SetClipRects(DamageRegion& damage)
+	{
+		if (!initialized_ || framebuffer_.empty())
+			return false;
+
+		if (fullRedrawPending_ || damage.GetWidth() != width_ || damage.GetHeight() != height_)
+		{
+			damage.Reset(width_, height_);
+			damage.AddAll();
+		}
+
+		clipRects_ = damage.GetRects();
+		return !clipRects_.empty();
+	}
+
+	void SoftwareBackend::ExecuteDrawListPartial(const DrawList& drawList, DamageRegion& damage)
+	{
+		if (!SetClipRects(damage))
+			return;
+
+		BeginPrimitives();
+		BuildPrimitives(drawList);
+		BinPrimitives();
+		Rasterize();
+		fullRedrawPending_ = false;
+	}
+
+	void SoftwareBackend::ExecuteDrawChainPartial(const DrawChain& chain, DamageRegion& damage)
+	{
+		if (!SetClipRects(damage))
+			return;
+
+		// Primitives reference the atlas, not the lists, so the lists can be
+		// converted one after another
+		BeginPrimitives();
+		chain.ForEachList([this](const DrawList& list) { BuildPrimitives(list); });
+		BinPrimitives();
+		Rasterize();
+		fullRedrawPending_ = false;
+	}
+
+	void SoftwareBackend::Rasterize()
+	{
+		pool_->ParallelFor(tileBins_.size(), [this](size_t tileIndex) { RasterizeTile(tileIndex); });
+	}
+
+	bool SoftwareBackend::ReadPixels(std::vector<uint8_t>& pixels) const
+	{
+		if (!initialized_ || framebuffer_.empty())
+			return false;
+
+		pixels.resize(framebuffer_.size() * 4);
+		std::memcpy(pixels.data(), framebuffer_.data(), pixels.size());
+		return true;
+	}
+
+	void SoftwareBackend::AddRect(float x0, float y0, float x1, float y1, const Color& color, PrimitiveType type)
+	{
+		// A pixel is covered when its center lies inside the rect
+		Primitive prim;
+		prim.type = type;
+		prim.color = ColorToPremultipliedRGBA8(color);
+		prim.alpha = ColorToByte(color.a);
+		prim.x0 = std::max(0, static_cast<int>(std::ceil(x0 - 0.5f)));
+		prim.y0 = std::max(0, static_cast<int>(std::ceil(y0 - 0.5f)));
+		prim.x1 = std::min(width_, static_cast<int>(std::ceil(x1 - 0.5f)));
+		prim.y1 = std::min(height_, static_cast<int>(std::ceil(y1 - 0.5f)));
+		prim.lx0 = prim.ly0 = prim.lx1 = prim.ly1 = 0.0f;
+		prim.srcX = prim.srcY = 0;
+
+		if (prim.x0 >= prim.x1 || prim.y0 >= prim.y1)
+			return;
+		if (type == PrimitiveType::Blend && prim.alpha == 0)
+			return;
+		if (type == PrimitiveType::Blend && prim.alpha == 255)
+			prim.type = PrimitiveType::Fill;
+
+		primitives_.push_back(prim);
+	}
+
+	void SoftwareBackend::AddLine(float x1, float y1, float x2, float y2, const Color& color)
+	{
+		Primitive prim;
+		prim.type = PrimitiveType::Line;
+		prim.color = ColorToPremultipliedRGBA8(color);
+		prim.alpha = ColorToByte(color.a);
+		prim.x0 = std::max(0, static_cast<int>(std::floor(std::min(x1, x2))));
+		prim.y0 = std::max(0, static_cast<int>(std::floor(std::min(y1, y2))));
+		prim.x1 = std::min(width_, static_cast<int>(std::floor(std::max(x1, x2))) + 1);
+		prim.y1 = std::min(height_, static_cast<int>(std::floor(std::max(y1, y2))) + 1);
+		prim.lx0 = x1;
+		prim.ly0 = y1;
+		prim.lx1 = x2;
+		prim.ly1 = y2;
+		prim.srcX = prim.srcY = 0;
+
+		if (prim.x0 >= prim.x1 || prim.y0 >= prim.y1 || prim.alpha == 0)
+			return;
+
+		primitives_.push_back(prim);
+	}
+
+	void SoftwareBackend::AddGlyph(const GlyphQuad& quad, const Color& color)
+	{
+		// Glyph quads are pixel-aligned, so atlas texels map 1:1 onto pixels
+		const int qx = static_cast<int>(quad.x0);
+		const int qy = static_cast<int>(quad.y0);
+
+		Primitive prim;
+		prim.type = PrimitiveType::Glyph;
+		prim.color = ColorToPremultipliedRGBA8(color);
+		prim.alpha = ColorToByte(color.a);
+		prim.x0 = std::max(0, qx);
+		prim.y0 = std::max(0, qy);
+		prim.x1 = std::min(width_, qx + quad.glyph->width);
+		prim.y1 = std::min(height_, qy + quad.glyph->height);
+		prim.lx0 = prim.ly0 = prim.lx1 = prim.ly1 = 0.0f;
+		prim.srcX = quad.glyph->x - qx;
+		prim.srcY = quad.glyph->y - qy;
+
+		if (prim.x0 >= prim.x1 || prim.y0 >= prim.y1 || prim.alpha == 0)
+			return;
+
+		primitives_.push_back(prim);
+	}
+
+	void SoftwareBackend::BeginPrimitives()
+	{
+		primitives_.clear();
+		glyphCache_.BeginFrame();
+	}
+
+	void SoftwareBackend::BuildPrimitives(const DrawList& drawList)
+	{
+		for (const auto& cmd : drawList.GetCommands())
+		{
+			switch (cmd.type)
+			{
+			case DrawCommandType::Clear:
+				// Everything recorded before a clear is invisible
+				primitives_.clear();
+				AddRect(0.0f, 0.0f, static_cast<float>(width_), static_cast<float>(height_), cmd.color,
+				        PrimitiveType::Fill);
+				break;
+			case DrawCommandType::DrawRect:
+				AddRect(cmd.rect.x, cmd.rect.y, cmd.rect.x + cmd.rect.width, cmd.rect.y + cmd.rect.height, cmd.color,
+				        PrimitiveType::Blend);
+				break;
+			case DrawCommandType::DrawText:
+				glyphCache_.LayoutRun(drawList.GetText(cmd), cmd.font, cmd.fontSize, cmd.rect.x, cmd.rect.y,
+				                      [&](const GlyphQuad& quad) { AddGlyph(quad, cmd.color); });
+				break;
+			case DrawCommandType::DrawLine:
+				// rect.x, rect.y = start point; rect.width, rect.height = end point
+				AddLine(cmd.rect.x, cmd.rect.y, cmd.rect.width, cmd.rect.height, cmd.color);
+				break;
+			}
+		}
+	}
+
+	void SoftwareBackend::BinPrimitives()
+	{
+		for (auto& bin : tileBins_)
+		{
+			bin.clear();
+		}
+
+		// Tiles outside the clip rects are never rasterized, so skip binning them
+		int clipX0 = width_, clipY0 = height_, clipX1 = 0, clipY1 = 0;
+		for (const DamageRect& clip : clipRects_)
+		{
+			clipX0 = std::min(clipX0, clip.x);
+			clipY0 = std::min(clipY0, clip.y);
+			clipX1 = std::max(clipX1, clip.Right());
+			clipY1 = std::max(clipY1, clip.Bottom());
+		}
+		if (clipX0 >= clipX1 || clipY0 >= clipY1)
+			return;
+
+		for (size_t i = 0; i < primitives_.size(); ++i)
+		{
+			const Primitive& prim = primitives_[i];
+			const int x0 = std::max(prim.x0, clipX0);
+			const int y0 = std::max(prim.y0, clipY0);
+			const int x1 = std::min(prim.x1, clipX1);
+			const int y1 = std::min(prim.y1, clipY1);
+			if (x0 >= x1 || y0 >= y1)
+				continue;
+
+			int tx0 = x0 / kTileSize;
+			int ty0 = y0 / kTileSize;
+			int tx1 = (x1 - 1) / kTileSize;
+			int ty1 = (y1 - 1) / kTileSize;
+
+			for (int ty = ty0; ty <= ty1; ++ty)
+			{
+				for (int tx = tx0; tx <= tx1; ++tx)
+				{
+					tileBins_[static_cast<size_t>(ty) * tilesX_ + tx].push_back(static_cast<uint32_t>(i));
+				}
+			}
+		}
+	}
+
+	void SoftwareBackend::RasterizeTile(size_t tileIndex)
+	{
+		const int tx = static_cast<int>(tileIndex % static_cast<size_t>(tilesX_));
+		const int ty = static_cast<int>(tileIndex / static_cast<size_t>(tilesX_));
+		const int tileX0 = tx * kTileSize;
+		const int tileY0 = ty * kTileSize;
+		const int tileX1 = std::min(tileX0 + kTileSize, width_);
+		const int tileY1 = std::min(tileY0 + kTileSize, height_);
+
+		// Clip rects are disjoint, so every pixel is replayed at most once
+		for (const DamageRect& clip : clipRects_)
+		{
+			const int clipX0 = std::max(tileX0, clip.x);
+			const int clipY0 = std::max(tileY0, clip.y);
+			const int clipX1 = std::min(tileX1, clip.Right());
+			const int clipY1 = std::min(tileY1, clip.Bottom());
+			if (clipX0 >= clipX1 || clipY0 >= clipY1)
+				continue;
+
+			for (uint32_t primIndex : tileBins_[tileIndex])
+			{
+				const Primitive& prim = primitives_[primIndex];
+				int x0 = std::max(prim.x0, clipX0);
+				int y0 = std::max(prim.y0, clipY0);
+				int x1 = std::min(prim.x1, clipX1);
+				int y1 = std::min(prim.y1, clipY1);
+				if (x0 >= x1 || y0 >= y1)
+					continue;
+
+				if (prim.type == PrimitiveType::Line)
+					DrawLineClipped(prim, x0, y0, x1, y1);
+				else if (prim.type == PrimitiveType::Glyph)
+					DrawGlyph(prim, x0, y0, x1, y1);
+				else
+					FillRect(prim, x0, y0, x1, y1);
+			}
+		}
+	}
+
+	void SoftwareBackend::FillRect(const Primitive& prim, int x0, int y0, int x1, int y1)
+	{
+		const size_t spanWidth = static_cast<size_t>(x1 - x0);
+		auto span = prim.type == PrimitiveType::Fill ? kernels_->fillSolid : kernels_->blendSolid;
+
+		for (int y = y0; y < y1; ++y)
+		{
+			span(framebuffer_.data() + static_cast<size_t>(y) * width_ + x0, spanWidth, prim.color);
+		}
+	}
+
+	void SoftwareBackend::DrawGlyph(const Primitive& prim, int x0, int y0, int x1, int y1)
+	{
+		// The atlas is only written while primitives are built, so tiles can
+		// read it concurrently
+		const uint8_t* atlas = glyphCache_.GetAtlasPixels();
+		const size_t atlasSize = static_cast<size_t>(glyphCache_.GetAtlasSize());
+		const size_t spanWidth = static_cast<size_t>(x1 - x0);
+
+		for (int y = y0; y < y1; ++y)
+		{
+			const uint8_t* coverage = atlas + static_cast<size_t>(y + prim.srcY) * atlasSize + (x0 + prim.srcX);
+			kernels_->blendMask(framebuffer_.data() + static_cast<size_t>(y) * width_ + x0, coverage, spanWidth,
+			                    prim.color);
+		}
+	}
+
+	void SoftwareBackend::DrawLineClipped(const Primitive& prim, int x0, int y0, int x1, int y1)
+	{
+		// DDA with one sample per major-axis step. The parametric range is first
+		// narrowed to the clip box so a long line costs O(tile) per tile.
+		const float dx = prim.lx1 - prim.lx0;
+		const float dy = prim.ly1 - prim.ly0;
+		const int steps = std::max(1, static_cast<int>(std::ceil(std::max(std::fabs(dx), std::fabs(dy)))));
+
+		float t0 = 0.0f;
+		float t1 = 1.0f;
+		const float p[4] = {-dx, dx, -dy, dy};
+		const float q[4] = {prim.lx0 - (x0 - 1), (x1 + 1) - prim.lx0, prim.ly0 - (y0 - 1), (y1 + 1) - prim.ly0};
+		for (int i = 0; i < 4; ++i)
+		{
+			if (p[i] == 0.0f)
+			{
+				if (q[i] < 0.0f)
+					return;
+				continue;
+			}
+			float t = q[i] / p[i];
+			if (p[i] < 0.0f)
+				t0 = std::max(t0, t);
+			else
+				t1 = std::min(t1, t);
+		}
+		if (t0 > t1)
+			return;
+
+		const int first = std::max(0, static_cast<int>(std::floor(t0 * steps)));
+		const int last = std::min(steps, static_cast<int>(std::ceil(t1 * steps)));
+
+		for (int i = first; i < last; ++i)
+		{
+			float t = static_cast<float>(i) / steps;
+			int px = static_cast<int>(std::floor(prim.lx0 + dx * t));
+			int py = static_cast<int>(std::floor(prim.ly0 + dy * t));
+			if (px < x0 || px >= x1 || py < y0 || py >= y1)
+				continue;
+
+			uint32_t* pixel = framebuffer_.data() + static_cast<size_t>(py) * width_ + px;
+			if (prim.alpha == 255)
+				*pixel = prim.color;
+			else
+				kernels_->blendSolid(pixel, 1, prim.color);
+		}
+	}
+
+} // namespace SnowUI
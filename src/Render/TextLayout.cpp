@@ -0,0 +1,197 @@
+#include "SnowUI/Render/TextLayout.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SnowUI
+{
+
+	static constexpr size_t kDefaultMeasureCapacity = 1 << 18;
+
+	// 64-bit FNV-1a
+	static uint64_t HashText(std::string_view text)
+	{
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (char c : text)
+		{
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+	TextMeasureCache& TextMeasureCache::Instance()
+	{
+		static TextMeasureCache cache;
+		return cache;
+	}
+
+	TextMeasureCache::TextMeasureCache() : shardCapacity_(kDefaultMeasureCapacity / kShardCount)
+	{
+		const uint32_t generation = FontRegistry::Instance().GetGeneration();
+		for (Shard& shard : shards_)
+		{
+			shard.fontGeneration = generation;
+		}
+	}
+
+	void TextMeasureCache::SetCapacity(size_t capacity)
+	{
+		const size_t shardCapacity = std::max<size_t>(capacity / kShardCount, 1);
+		shardCapacity_.store(shardCapacity, std::memory_order_relaxed);
+		for (Shard& shard : shards_)
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			if (shard.entries.size() > shardCapacity)
+				shard.entries.clear();
+		}
+	}
+
+	TextMeasureStats TextMeasureCache::GetStats() const
+	{
+		TextMeasureStats stats;
+		for (const Shard& shard : shards_)
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			stats.hits += shard.hits;
+			stats.misses += shard.misses;
+			stats.entryCount += shard.entries.size();
+		}
+		return stats;
+	}
+
+	void TextMeasureCache::Clear()
+	{
+		for (Shard& shard : shards_)
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.entries.clear();
+			shard.asciiAdvances.clear();
+		}
+	}
+
+	void TextMeasureCache::CheckGeneration(Shard& shard)
+	{
+		const uint32_t generation = FontRegistry::Instance().GetGeneration();
+		if (generation != shard.fontGeneration)
+		{
+			shard.entries.clear();
+			shard.asciiAdvances.clear();
+			shard.fontGeneration = generation;
+		}
+	}
+
+	const TextMeasureCache::AsciiAdvances& TextMeasureCache::GetAsciiAdvances(Shard& shard, FontId font,
+	                                                                          uint16_t size)
+	{
+		const uint32_t key = (static_cast<uint32_t>(font) << 16) | size;
+		auto it = shard.asciiAdvances.find(key);
+		if (it != shard.asciiAdvances.end())
+			return it->second;
+
+		FontRegistry& registry = FontRegistry::Instance();
+		AsciiAdvances advances;
+		advances.metrics = registry.GetMetrics(font, size);
+		advances.advance.fill(0.0f);
+		for (uint32_t c = 0x20; c < 0x7F; ++c)
+		{
+			advances.advance[c] = registry.GetAdvance(font, size, c);
+		}
+		return shard.asciiAdvances.emplace(key, advances).first->second;
+	}
+
+	TextMetrics TextMeasureCache::Compute(Shard& shard, std::string_view text, FontId font, uint16_t size)
+	{
+		const AsciiAdvances& advances = GetAsciiAdvances(shard, font, size);
+
+		// Must match GlyphCache::LayoutRun, which also sums unkerned advances
+		float width = 0.0f;
+		for (size_t i = 0; i < text.size();)
+		{
+			const uint32_t codepoint = DecodeUTF8(text, i);
+			if (codepoint < 0x80)
+				width += advances.advance[codepoint];
+			else
+				width += FontRegistry::Instance().GetAdvance(font, size, codepoint);
+		}
+
+		TextMetrics metrics;
+		metrics.width = width;
+		metrics.height = advances.metrics.lineHeight;
+		metrics.ascent = advances.metrics.ascent;
+		return metrics;
+	}
+
+	TextMetrics TextMeasureCache::Measure(std::string_view text, FontId font, uint16_t size)
+	{
+		const Key key{HashText(text), font, size};
+		// The high bits pick the shard; the map buckets use the whole hash
+		Shard& shard = shards_[static_cast<size_t>(key.hash >> 32) % kShardCount];
+
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		CheckGeneration(shard);
+
+		auto range = shard.entries.equal_range(key);
+		for (auto it = range.first; it != range.second; ++it)
+		{
+			if (it->second.text == text)
+			{
+				shard.hits++;
+				return it->second.metrics;
+			}
+		}
+
+		shard.misses++;
+		if (shard.entries.size() >= shardCapacity_.load(std::memory_order_relaxed))
+		{
+			// Flushing wholesale keeps lookups free of LRU bookkeeping; working
+			// sets that fit are rebuilt within a frame
+			shard.entries.clear();
+		}
+
+		Entry entry;
+		entry.text.assign(text.data(), text.size());
+		entry.metrics = Compute(shard, text, font, size);
+		const TextMetrics metrics = entry.metrics;
+		shard.entries.emplace(key, std::move(entry));
+		return metrics;
+	}
+
+	TextLayout LayoutText(std::string_view text, const Rect& bounds, TextAlign horizontal, TextAlign vertical,
+	                      FontId font, uint16_t size)
+	{
+		TextLayout layout;
+		layout.metrics = MeasureText(text, font, size);
+
+		switch (horizontal)
+		{
+		case TextAlign::Start:
+			layout.x = bounds.x;
+			break;
+		case TextAlign::Center:
+			layout.x = bounds.x + (bounds.width - layout.metrics.width) / 2.0f;
+			break;
+		case TextAlign::End:
+			layout.x = bounds.x + bounds.width - layout.metrics.width;
+			break;
+		}
+
+		switch (vertical)
+		{
+		case TextAlign::Start:
+			layout.y = bounds.y;
+			break;
+		case TextAlign::Center:
+			layout.y = bounds.y + (bounds.height - layout.metrics.height) / 2.0f;
+			break;
+		case TextAlign::End:
+			layout.y = bounds.y + bounds.height - layout.metrics.height;
+			break;
+		}
+
+		// Whole pixels keep glyph quads aligned with atlas texels
+		layout.x = std::round(layout.x);
+		layout.y = std::round(layout.y);
+		return layout;
+	}
+
+} // namespace SnowUI
@@ -1,12 +1,19 @@
 #include "SnowUI/Widgets/Button.h"
+#include "SnowUI/Render/TextLayout.h"
 
 namespace SnowUI
 {
 
-	Button::Button() : onClick_(nullptr), isPressed_(false)
+	Button::Button() : onClick_(0), isPressed_(false)
 	{
 	}
 
+	void Button::SetOnClick(Delegate<void()> callback)
+	{
+		click_.Disconnect(onClick_);
+		onClick_ = callback ? click_.Connect(std::move(callback)) : 0;
+	}
+
 	void Button::OnPaint(DrawList& drawList)
 	{
 		if (!visible_)
@@ -17,9 +24,8 @@ namespace SnowUI
 
 		if (!text_.empty())
 		{
-			float centerX = bounds_.x + bounds_.width / 2.0f;
-			float centerY = bounds_.y + bounds_.height / 2.0f;
-			drawList.AddText(text_, centerX, centerY, Color(1.0f, 1.0f, 1.0f, 1.0f));
+			TextLayout layout = LayoutText(text_, bounds_, TextAlign::Center, TextAlign::Center);
+			drawList.AddText(text_, layout.x, layout.y, Color(1.0f, 1.0f, 1.0f, 1.0f));
 		}
 	}
 
@@ -28,24 +34,42 @@ namespace SnowUI
 		if (!visible_)
 			return;
 
+		float mx = static_cast<float>(event.x);
+		float my = static_cast<float>(event.y);
+		bool inside =
+			mx >= bounds_.x && mx <= bounds_.x + bounds_.width && my >= bounds_.y && my <= bounds_.y + bounds_.height;
+
 		if (event.type == EventType::MouseDown)
 		{
-			float mx = static_cast<float>(event.x);
-			float my = static_cast<float>(event.y);
-			if (mx >= bounds_.x && mx <= bounds_.x + bounds_.width && my >= bounds_.y &&
-			    my <= bounds_.y + bounds_.height)
+			if (inside)
 			{
 				isPressed_ = true;
+				Invalidate();
+				event.handled = true;
 			}
 		}
 		else if (event.type == EventType::MouseUp)
 		{
-			if (isPressed_ && onClick_)
+			// The window keeps sending mouse events to the pressed button, so a
+			// release outside it cancels the click
+			if (isPressed_)
 			{
-				onClick_();
+				isPressed_ = false;
+				Invalidate();
+				event.handled = true;
+				if (inside)
+				{
+					click_.Emit();
+				}
 			}
-			isPressed_ = false;
 		}
 	}
 
+	Size Button::OnMeasure()
+	{
+		// Room for the label plus a margin on each side
+		const TextMetrics metrics = MeasureText(text_);
+		return Size(metrics.width + 16.0f, metrics.height + 8.0f);
+	}
+
 } // namespace SnowUI
@@ -0,0 +1,332 @@
+#include "SnowUI/Widgets/DataGrid.h"
+#include "SnowUI/Render/TextLayout.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SnowUI
+{
+
+	static constexpr float kCellPadding = 5.0f;
+	static constexpr float kMinColumnWidth = 24.0f;
+	static constexpr double kWheelRows = 3.0;
+	// Screens of rows the cell cache holds, so short scrolls hit it
+	static constexpr size_t kCachedScreens = 3;
+
+	DataGrid::DataGrid() : source_(nullptr), rowCount_(0), selectedRow_(kNoRow)
+	{
+		scroll_.SetViewport(GetBodyRect());
+		ResizeCache();
+	}
+
+	Rect DataGrid::GetBodyRect() const
+	{
+		const float headerHeight = std::min(kHeaderHeight, bounds_.height);
+		return Rect(bounds_.x, bounds_.y + headerHeight, bounds_.width, bounds_.height - headerHeight);
+	}
+
+	void DataGrid::SetBounds(const Rect& bounds)
+	{
+		Widget::SetBounds(bounds);
+		scroll_.SetViewport(GetBodyRect());
+		ResizeCache();
+	}
+
+	void DataGrid::SetDataSource(IDataSource* source)
+	{
+		source_ = source;
+		columnNames_.clear();
+		if (source_)
+		{
+			columnNames_.resize(source_->GetColumnCount());
+			for (size_t column = 0; column < columnNames_.size(); ++column)
+			{
+				columnNames_[column] = source_->GetColumnName(column);
+			}
+		}
+		columnWidths_.assign(columnNames_.size(), 0.0f);
+		selectedRow_ = kNoRow;
+		scroll_.SetOffset(0.0);
+		Refresh();
+		AutoSizeColumns();
+	}
+
+	void DataGrid::Refresh()
+	{
+		rowCount_ = source_ ? source_->GetRowCount() : 0;
+		if (selectedRow_ != kNoRow && selectedRow_ >= rowCount_)
+			selectedRow_ = kNoRow;
+		ClearCache();
+		UpdateScrollRange();
+		Invalidate();
+	}
+
+	void DataGrid::UpdateScrollRange()
+	{
+		scroll_.SetContentHeight(static_cast<double>(rowCount_) * kRowHeight);
+	}
+
+	void DataGrid::ResizeCache()
+	{
+		const size_t screenRows = static_cast<size_t>(std::ceil(std::max(bounds_.height, 0.0f) / kRowHeight)) + 1;
+		const size_t capacity = std::max<size_t>(screenRows * kCachedScreens, 16);
+		if (capacity == cache_.size())
+			return;
+
+		// Slots are keyed by row modulo the capacity, so they all move
+		cache_.resize(capacity);
+		ClearCache();
+	}
+
+	void DataGrid::ClearCache()
+	{
+		for (auto& slot : cache_)
+		{
+			slot.row = kNoRow;
+		}
+	}
+
+	const std::vector<DataGrid::Cell>& DataGrid::GetRowCells(size_t row)
+	{
+		CachedRow& slot = cache_[row % cache_.size()];
+		if (slot.row == row)
+		{
+			cacheStats_.hits++;
+			return slot.cells;
+		}
+
+		cacheStats_.misses++;
+		slot.row = row;
+		slot.cells.resize(columnNames_.size());
+		for (size_t column = 0; column < slot.cells.size(); ++column)
+		{
+			// The old strings' capacity is reused, so a warm cache formats
+			// without allocating
+			Cell& cell = slot.cells[column];
+			source_->FormatCell(row, column, cell.text);
+			cell.width = MeasureText(cell.text).width;
+		}
+		return slot.cells;
+	}
+
+	void DataGrid::InvalidateRows(size_t first, size_t count)
+	{
+		if (first >= rowCount_ || count == 0)
+			return;
+
+		const size_t end = first + std::min(count, rowCount_ - first);
+		for (auto& slot : cache_)
+		{
+			if (slot.row != kNoRow && slot.row >= first && slot.row < end)
+				slot.row = kNoRow;
+		}
+
+		size_t visibleFirst, visibleLast;
+		GetVisibleRange(visibleFirst, visibleLast);
+		const size_t damagedFirst = std::max(first, visibleFirst);
+		const size_t damagedLast = std::min(end, visibleLast);
+		if (damagedFirst >= damagedLast)
+			return;
+
+		const Rect body = GetBodyRect();
+		const float top = std::max(GetRowTop(damagedFirst), body.y);
+		const float bottom = std::min(GetRowTop(damagedLast), body.y + body.height);
+		InvalidateArea(Rect(body.x, top, body.width, bottom - top));
+	}
+
+	void DataGrid::AutoSizeColumns()
+	{
+		if (columnNames_.empty())
+			return;
+
+		std::vector<float> widths(columnNames_.size());
+		for (size_t column = 0; column < widths.size(); ++column)
+		{
+			widths[column] = MeasureText(columnNames_[column]).width;
+		}
+
+		// Evenly spaced rows, always including the first and the last
+		const size_t samples = std::min(rowCount_, kSampleRows);
+		for (size_t i = 0; i < samples; ++i)
+		{
+			const double step = samples > 1 ? static_cast<double>(rowCount_ - 1) / (samples - 1) : 0.0;
+			const size_t row = static_cast<size_t>(static_cast<double>(i) * step);
+			for (size_t column = 0; column < widths.size(); ++column)
+			{
+				source_->FormatCell(row, column, scratch_);
+				widths[column] = std::max(widths[column], MeasureText(scratch_).width);
+			}
+		}
+
+		for (size_t column = 0; column < widths.size(); ++column)
+		{
+			columnWidths_[column] = std::max(std::ceil(widths[column] + 2.0f * kCellPadding), kMinColumnWidth);
+		}
+		Invalidate();
+	}
+
+	void DataGrid::SetColumnWidth(size_t column, float width)
+	{
+		if (column >= columnWidths_.size())
+			return;
+
+		width = std::max(std::round(width), kMinColumnWidth);
+		if (columnWidths_[column] == width)
+			return;
+
+		columnWidths_[column] = width;
+		Invalidate();
+	}
+
+	void DataGrid::SetScrollOffset(double offset)
+	{
+		if (scroll_.SetOffset(offset))
+		{
+			Invalidate();
+		}
+	}
+
+	void DataGrid::EnsureVisible(size_t row)
+	{
+		if (row >= rowCount_)
+			return;
+
+		const double top = static_cast<double>(row) * kRowHeight;
+		if (scroll_.ScrollIntoView(top, top + kRowHeight))
+		{
+			Invalidate();
+		}
+	}
+
+	void DataGrid::SetSelectedRow(size_t row)
+	{
+		if (row != kNoRow && row >= rowCount_)
+			row = kNoRow;
+		if (row == selectedRow_)
+			return;
+
+		selectedRow_ = row;
+		Invalidate();
+	}
+
+	float DataGrid::GetRowTop(size_t row) const
+	{
+		const double contentY = static_cast<double>(row) * kRowHeight;
+		return GetBodyRect().y + static_cast<float>(contentY - scroll_.GetOffset());
+	}
+
+	void DataGrid::GetVisibleRange(size_t& first, size_t& last) const
+	{
+		const double offset = scroll_.GetOffset();
+		const double height = std::max(GetBodyRect().height, 0.0f);
+		first = static_cast<size_t>(offset / kRowHeight);
+		last = std::min(static_cast<size_t>(std::ceil((offset + height) / kRowHeight)), rowCount_);
+		first = std::min(first, last);
+	}
+
+	size_t DataGrid::GetRowAt(float x, float y) const
+	{
+		const Rect body = GetBodyRect();
+		if (x < body.x || x > body.x + body.width || y < body.y || y >= body.y + body.height)
+			return kNoRow;
+
+		const size_t row = static_cast<size_t>((y - body.y + scroll_.GetOffset()) / kRowHeight);
+		return row < rowCount_ ? row : kNoRow;
+	}
+
+	void DataGrid::OnPaint(DrawList& drawList)
+	{
+		if (!visible_)
+			return;
+
+		drawList.AddRect(bounds_, Color(0.25f, 0.25f, 0.25f, 1.0f));
+
+		const Rect body = GetBodyRect();
+		const float right = body.x + (scroll_.IsShown() ? body.width - ScrollBar::kWidth : body.width);
+		const float lineHeight = MeasureText("").height;
+
+		// Header
+		const float headerHeight = bounds_.height - body.height;
+		drawList.AddRect(Rect(bounds_.x, bounds_.y, bounds_.width, headerHeight), Color(0.3f, 0.3f, 0.35f, 1.0f));
+		float x = bounds_.x;
+		for (size_t column = 0; column < columnNames_.size() && x < right; ++column)
+		{
+			const float textY = bounds_.y + std::round((headerHeight - lineHeight) * 0.5f);
+			if (x + kCellPadding + MeasureText(columnNames_[column]).width <= right)
+			{
+				drawList.AddText(columnNames_[column], x + kCellPadding, textY, Color(0.9f, 0.9f, 0.9f, 1.0f));
+			}
+			x += columnWidths_[column];
+			if (x < right)
+			{
+				drawList.AddLine(x, bounds_.y, x, body.y + body.height, Color(0.35f, 0.35f, 0.35f, 1.0f));
+			}
+		}
+
+		if (!source_ || body.height <= 0.0f)
+		{
+			scroll_.Paint(drawList);
+			return;
+		}
+
+		size_t first, last;
+		GetVisibleRange(first, last);
+		const float bottom = body.y + body.height;
+		for (size_t row = first; row < last; ++row)
+		{
+			const float y = GetRowTop(row);
+			if (row == selectedRow_)
+			{
+				const float selTop = std::max(y, body.y);
+				const float selBottom = std::min(y + kRowHeight, bottom);
+				drawList.AddRect(Rect(body.x, selTop, right - body.x, selBottom - selTop),
+				                 Color(0.4f, 0.4f, 0.6f, 1.0f));
+			}
+
+			// Text has no clipping, so rows cut by the edges show only their
+			// background, and cells are dropped where they would leave the grid
+			const float textY = y + std::round((kRowHeight - lineHeight) * 0.5f);
+			if (textY < body.y || textY + lineHeight > bottom)
+				continue;
+
+			const std::vector<Cell>& cells = GetRowCells(row);
+			float cellX = body.x;
+			for (size_t column = 0; column < cells.size() && cellX < right; ++column)
+			{
+				const Cell& cell = cells[column];
+				if (!cell.text.empty() && cellX + kCellPadding + cell.width <= right)
+				{
+					drawList.AddText(cell.text, cellX + kCellPadding, textY, Color(1.0f, 1.0f, 1.0f, 1.0f));
+				}
+				cellX += columnWidths_[column];
+			}
+		}
+
+		scroll_.Paint(drawList);
+	}
+
+	void DataGrid::OnEvent(const Event& event)
+	{
+		if (!visible_)
+			return;
+
+		bool scrolled = false;
+		if (scroll_.HandleEvent(event, kWheelRows * kRowHeight, scrolled))
+		{
+			if (scrolled)
+				Invalidate();
+			event.handled = true;
+			return;
+		}
+
+		if (event.type == EventType::MouseDown)
+		{
+			const size_t row = GetRowAt(static_cast<float>(event.x), static_cast<float>(event.y));
+			if (row != kNoRow)
+			{
+				SetSelectedRow(row);
+				event.handled = true;
+			}
+		}
+	}
+
+} // namespace SnowUI
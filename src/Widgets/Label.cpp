@@ -1,4 +1,5 @@
 #include "SnowUI/Widgets/Label.h"
+#include "SnowUI/Render/TextLayout.h"
 
 namespace SnowUI
 {
@@ -18,4 +19,12 @@ namespace SnowUI
 		}
 	}
 
+	Size Label::OnMeasure()
+	{
+		if (text_.empty())
+			return Size();
+		const TextMetrics metrics = MeasureText(text_);
+		return Size(metrics.width, metrics.height);
+	}
+
 } // namespace SnowUI
@@ -1,10 +1,142 @@
 #include "SnowUI/Widgets/PropertyGrid.h"
+#include "SnowUI/Render/TextLayout.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
 
 namespace SnowUI
 {
 
-	PropertyGrid::PropertyGrid() : selectedIndex_(-1)
+	static constexpr float kCellPadding = 5.0f;
+	static constexpr float kWheelRows = 3.0f; // rows scrolled per wheel notch
+
+	bool PropertyValue::operator==(const PropertyValue& other) const
 	{
+		if (type != other.type)
+			return false;
+
+		switch (type)
+		{
+		case PropertyType::String:
+			return stringValue == other.stringValue;
+		case PropertyType::Int:
+			return intValue == other.intValue;
+		case PropertyType::Float:
+			return floatValue == other.floatValue;
+		case PropertyType::Bool:
+			return boolValue == other.boolValue;
+		case PropertyType::Color:
+			return colorValue == other.colorValue;
+		}
+		return false;
+	}
+
+	void PropertyValue::Format(std::string& out) const
+	{
+		char buffer[32];
+		switch (type)
+		{
+		case PropertyType::String:
+			out = stringValue;
+			return;
+		case PropertyType::Int:
+			std::snprintf(buffer, sizeof(buffer), "%" PRId64, intValue);
+			break;
+		case PropertyType::Float:
+			std::snprintf(buffer, sizeof(buffer), "%g", floatValue);
+			break;
+		case PropertyType::Bool:
+			out = boolValue ? "true" : "false";
+			return;
+		case PropertyType::Color:
+			std::snprintf(buffer, sizeof(buffer), "#%08X", static_cast<unsigned>(colorValue));
+			break;
+		}
+		out = buffer;
+	}
+
+	PropertyGrid::PropertyGrid() : filterActive_(false), selectedId_(kNoProperty), maxNameWidth_(0.0f)
+	{
+		scroll_.SetViewport(bounds_);
+	}
+
+	float PropertyGrid::GetValueColumnOffset() const
+	{
+		// Fit the widest name, but never squeeze either column below a quarter
+		// of the grid
+		const float fitted = maxNameWidth_ + 3.0f * kCellPadding;
+		return std::round(std::min(std::max(fitted, bounds_.width * 0.25f), bounds_.width * 0.75f));
+	}
+
+	void PropertyGrid::UpdateScrollRange()
+	{
+		const double contentHeight = static_cast<double>(GetRowCount()) * kRowHeight + 2.0 * kCellPadding;
+		scroll_.SetContentHeight(contentHeight);
+	}
+
+	void PropertyGrid::SetScrollOffset(double offset)
+	{
+		if (scroll_.SetOffset(offset))
+		{
+			Invalidate();
+		}
+	}
+
+	void PropertyGrid::EnsureVisible(size_t row)
+	{
+		if (row >= GetRowCount())
+			return;
+
+		const double top = kCellPadding + static_cast<double>(row) * kRowHeight;
+		if (scroll_.ScrollIntoView(top, top + kRowHeight))
+		{
+			Invalidate();
+		}
+	}
+
+	int PropertyGrid::GetRowAt(float x, float y) const
+	{
+		if (x < bounds_.x || x > bounds_.x + bounds_.width || y < bounds_.y || y > bounds_.y + bounds_.height)
+			return -1;
+
+		const double contentY = y - bounds_.y + scroll_.GetOffset() - kCellPadding;
+		if (contentY < 0.0)
+			return -1;
+
+		const size_t row = static_cast<size_t>(contentY / kRowHeight);
+		return row < GetRowCount() ? static_cast<int>(row) : -1;
+	}
+
+	void PropertyGrid::GetVisibleRange(size_t& first, size_t& last) const
+	{
+		// Rows overlapping [offset, offset + height) in content space
+		const double offset = scroll_.GetOffset();
+		const double firstY = std::max(offset - kCellPadding, 0.0);
+		const double lastY = std::max(offset + bounds_.height - kCellPadding, 0.0);
+		first = static_cast<size_t>(firstY / kRowHeight);
+		last = std::min(static_cast<size_t>(std::ceil(lastY / kRowHeight)), GetRowCount());
+		first = std::min(first, last);
+	}
+
+	float PropertyGrid::GetRowTop(size_t row) const
+	{
+		const double contentY = kCellPadding + static_cast<double>(row) * kRowHeight;
+		return bounds_.y + static_cast<float>(contentY - scroll_.GetOffset());
+	}
+
+	Rect PropertyGrid::GetRowRect(size_t row) const
+	{
+		const float y = GetRowTop(row);
+		const float top = std::max(y, bounds_.y);
+		const float bottom = std::min(y + kRowHeight, bounds_.y + bounds_.height);
+		return Rect(bounds_.x, top, bounds_.width, std::max(bottom - top, 0.0f));
+	}
+
+	void PropertyGrid::SetBounds(const Rect& bounds)
+	{
+		Widget::SetBounds(bounds);
+		scroll_.SetViewport(bounds_);
 	}
 
 	void PropertyGrid::OnPaint(DrawList& drawList)
@@ -14,28 +146,58 @@ namespace SnowUI
 
 		// Draw background
 		drawList.AddRect(bounds_, Color(0.25f, 0.25f, 0.25f, 1.0f));
+		if (GetRowCount() == 0 || bounds_.height <= 0.0f)
+			return;
 
-		// Draw property items
-		float itemHeight = 25.0f;
-		float y = bounds_.y + 5.0f;
+		const float rowWidth = scroll_.IsShown() ? bounds_.width - ScrollBar::kWidth : bounds_.width;
+		const float valueX = bounds_.x + GetValueColumnOffset();
+		const float top = bounds_.y;
+		const float bottom = bounds_.y + bounds_.height;
+		const float lineHeight = MeasureText("").height;
 
-		for (size_t i = 0; i < items_.size(); ++i)
+		size_t first, last;
+		GetVisibleRange(first, last);
+
+		for (size_t i = first; i < last; ++i)
 		{
-			const auto& item = items_[i];
+			const PropertyId id = GetRowProperty(i);
+			Row& row = rows_[id];
+			const float y = GetRowTop(i);
 
-			// Highlight selected
-			if (static_cast<int>(i) == selectedIndex_)
+			// Highlight selected, cut to the grid so it never spills over
+			// neighbouring widgets
+			if (id == selectedId_)
 			{
-				Rect selRect(bounds_.x, y, bounds_.width, itemHeight);
+				Rect selRect = GetRowRect(i);
+				selRect.width = rowWidth;
 				drawList.AddRect(selRect, Color(0.4f, 0.4f, 0.6f, 1.0f));
 			}
 
-			// Draw name and value
-			drawList.AddText(item.name, bounds_.x + 5.0f, y + 5.0f, Color(0.8f, 0.8f, 0.8f, 1.0f));
-			drawList.AddText(item.value, bounds_.x + bounds_.width / 2.0f, y + 5.0f, Color(1.0f, 1.0f, 1.0f, 1.0f));
+			// Text has no clipping, so rows cut by the edges show only their
+			// background
+			const float textY = y + kCellPadding;
+			if (textY < top || textY + lineHeight > bottom)
+				continue;
+
+			// Strings are drawn as stored; other types are formatted once per
+			// change, and only once they scroll into view
+			const std::string* valueText = &row.value.stringValue;
+			if (row.value.type != PropertyType::String)
+			{
+				if (!row.formatValid)
+				{
+					row.value.Format(row.formatted);
+					row.formatValid = true;
+				}
+				valueText = &row.formatted;
+			}
 
-			y += itemHeight;
+			// Draw name and value
+			drawList.AddText(names_[row.nameId], bounds_.x + kCellPadding, textY, Color(0.8f, 0.8f, 0.8f, 1.0f));
+			drawList.AddText(*valueText, valueX, textY, Color(1.0f, 1.0f, 1.0f, 1.0f));
 		}
+
+		scroll_.Paint(drawList);
 	}
 
 	void PropertyGrid::OnEvent(const Event& event)
@@ -43,37 +205,175 @@ namespace SnowUI
 		if (!visible_)
 			return;
 
-		if (event.type == EventType::MouseDown)
+		bool scrolled = false;
+		if (scroll_.HandleEvent(event, kWheelRows * kRowHeight, scrolled))
 		{
-			float mx = static_cast<float>(event.x);
-			float my = static_cast<float>(event.y);
+			if (scrolled)
+				Invalidate();
+			event.handled = true;
+			return;
+		}
 
-			if (mx >= bounds_.x && mx <= bounds_.x + bounds_.width && my >= bounds_.y &&
-			    my <= bounds_.y + bounds_.height)
+		if (event.type == EventType::MouseDown)
+		{
+			const int row = GetRowAt(static_cast<float>(event.x), static_cast<float>(event.y));
+			if (row >= 0)
 			{
-				float itemHeight = 25.0f;
-				int index = static_cast<int>((my - bounds_.y - 5.0f) / itemHeight);
-				if (index >= 0 && index < static_cast<int>(items_.size()))
+				const PropertyId id = GetRowProperty(static_cast<size_t>(row));
+				if (id != selectedId_)
 				{
-					selectedIndex_ = index;
+					selectedId_ = id;
+					Invalidate();
 				}
+				event.handled = true;
 			}
 		}
 	}
 
-	void PropertyGrid::AddProperty(const std::string& name, const std::string& value, const std::string& type)
+	uint32_t PropertyGrid::InternName(std::string_view name)
+	{
+		auto it = nameIds_.find(name);
+		if (it != nameIds_.end())
+			return it->second;
+
+		const uint32_t id = static_cast<uint32_t>(names_.size());
+		names_.emplace_back(name);
+		nameIds_.emplace(names_.back(), id);
+		maxNameWidth_ = std::max(maxNameWidth_, MeasureText(name).width);
+		return id;
+	}
+
+	PropertyId PropertyGrid::AddProperty(std::string_view name, PropertyValue value)
+	{
+		Row row;
+		row.nameId = InternName(name);
+		row.formatValid = false;
+		row.value = std::move(value);
+		rows_.push_back(std::move(row));
+
+		const PropertyId id = nameIndex_.Add(name);
+		if (filterActive_ && TrigramIndex::Matches(name, filter_))
+		{
+			filteredRows_.push_back(id);
+		}
+		UpdateScrollRange();
+		Invalidate();
+		return id;
+	}
+
+	bool PropertyGrid::StoreValue(PropertyId id, const PropertyValue& value)
+	{
+		Row& row = rows_[id];
+		if (row.value == value)
+			return false;
+
+		row.value = value;
+		row.formatValid = false;
+		return true;
+	}
+
+	bool PropertyGrid::FindRow(PropertyId id, size_t& row) const
+	{
+		if (id >= rows_.size())
+			return false;
+		if (!filterActive_)
+		{
+			row = id;
+			return true;
+		}
+
+		auto it = std::lower_bound(filteredRows_.begin(), filteredRows_.end(), id);
+		if (it == filteredRows_.end() || *it != id)
+			return false;
+		row = static_cast<size_t>(it - filteredRows_.begin());
+		return true;
+	}
+
+	void PropertyGrid::InvalidateProperty(PropertyId id, size_t first, size_t last)
+	{
+		size_t row;
+		if (FindRow(id, row) && row >= first && row < last)
+		{
+			InvalidateArea(GetRowRect(row));
+		}
+	}
+
+	void PropertyGrid::SetValue(PropertyId id, const PropertyValue& value)
+	{
+		if (id < rows_.size() && StoreValue(id, value))
+		{
+			size_t first, last;
+			GetVisibleRange(first, last);
+			InvalidateProperty(id, first, last);
+			valueChanged_.Emit(id, rows_[id].value);
+		}
+	}
+
+	void PropertyGrid::SetValues(const PropertyUpdate* updates, size_t count)
+	{
+		size_t first, last;
+		GetVisibleRange(first, last);
+
+		// Off-screen rows only drop their formatted text; they are repainted
+		// when scrolled to, which repaints the whole grid anyway
+		for (size_t i = 0; i < count; ++i)
+		{
+			const PropertyId id = updates[i].id;
+			if (id < rows_.size() && StoreValue(id, updates[i].value))
+			{
+				InvalidateProperty(id, first, last);
+				valueChanged_.Emit(id, rows_[id].value);
+			}
+		}
+	}
+
+	void PropertyGrid::SetFilter(std::string_view text)
+	{
+		std::string folded;
+		TrigramIndex::Fold(text, folded);
+		if (folded == filter_ && filterActive_ == !folded.empty())
+			return;
+
+		if (folded.empty())
+		{
+			filterActive_ = false;
+			filteredRows_.clear();
+		}
+		else if (filterActive_ && folded.find(filter_) != std::string::npos)
+		{
+			// Typing narrows the filter: every new match is an old match
+			nameIndex_.Refine(folded, filteredRows_, filterScratch_);
+			filteredRows_.swap(filterScratch_);
+			filterActive_ = true;
+		}
+		else
+		{
+			nameIndex_.Search(folded, filteredRows_);
+			filterActive_ = true;
+		}
+		filter_ = std::move(folded);
+
+		UpdateScrollRange();
+		Invalidate();
+	}
+
+	void PropertyGrid::Reserve(size_t count)
 	{
-		PropertyItem item;
-		item.name = name;
-		item.value = value;
-		item.type = type;
-		items_.push_back(item);
+		rows_.reserve(count);
+		nameIndex_.Reserve(count, 0);
 	}
 
 	void PropertyGrid::Clear()
 	{
-		items_.clear();
-		selectedIndex_ = -1;
+		rows_.clear();
+		names_.clear();
+		nameIds_.clear();
+		nameIndex_.Clear();
+		filteredRows_.clear();
+		selectedId_ = kNoProperty;
+		maxNameWidth_ = 0.0f;
+		UpdateScrollRange();
+		Invalidate();
 	}
 
 } // namespace SnowUI
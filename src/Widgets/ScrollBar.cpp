@@ -0,0 +1,123 @@
+#include "SnowUI/Widgets/ScrollBar.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SnowUI
+{
+
+	static constexpr float kMinThumbHeight = 16.0f;
+
+	void ScrollBar::SetViewport(const Rect& viewport)
+	{
+		viewport_ = viewport;
+		// A taller viewport may leave the old offset past the end
+		SetOffset(offset_);
+	}
+
+	void ScrollBar::SetContentHeight(double height)
+	{
+		contentHeight_ = height;
+		SetOffset(offset_);
+	}
+
+	double ScrollBar::GetMaxOffset() const
+	{
+		return std::max(contentHeight_ - viewport_.height, 0.0);
+	}
+
+	bool ScrollBar::SetOffset(double offset)
+	{
+		offset = std::round(std::min(std::max(offset, 0.0), GetMaxOffset()));
+		if (offset == offset_)
+			return false;
+
+		offset_ = offset;
+		return true;
+	}
+
+	bool ScrollBar::ScrollIntoView(double top, double bottom)
+	{
+		if (top < offset_)
+			return SetOffset(top);
+		if (bottom > offset_ + viewport_.height)
+			return SetOffset(bottom - viewport_.height);
+		return false;
+	}
+
+	Rect ScrollBar::GetThumb() const
+	{
+		const float height = viewport_.height;
+		const float ratio = contentHeight_ > 0.0 ? static_cast<float>(height / contentHeight_) : 1.0f;
+		const float thumbHeight = std::min(std::max(height * ratio, kMinThumbHeight), height);
+		const double maxOffset = GetMaxOffset();
+		const float travel = height - thumbHeight;
+		const float thumbY = maxOffset > 0.0 ? static_cast<float>(travel * (offset_ / maxOffset)) : 0.0f;
+		return Rect(viewport_.x + viewport_.width - kWidth, viewport_.y + thumbY, kWidth, thumbHeight);
+	}
+
+	bool ScrollBar::HandleEvent(const Event& event, double wheelStep, bool& changed)
+	{
+		changed = false;
+		const float mx = static_cast<float>(event.x);
+		const float my = static_cast<float>(event.y);
+		const bool inViewport = mx >= viewport_.x && mx <= viewport_.x + viewport_.width && my >= viewport_.y &&
+		                        my <= viewport_.y + viewport_.height;
+
+		switch (event.type)
+		{
+		case EventType::MouseDown:
+			if (!IsShown() || !inViewport || mx < viewport_.x + viewport_.width - kWidth)
+				return false;
+			{
+				// Clicking the track jumps the thumb there, then drags it
+				const Rect thumb = GetThumb();
+				if (my < thumb.y || my > thumb.y + thumb.height)
+				{
+					const float travel = viewport_.height - thumb.height;
+					const float ratio = travel > 0.0f ? (my - viewport_.y - thumb.height * 0.5f) / travel : 0.0f;
+					SetOffset(static_cast<double>(ratio) * GetMaxOffset());
+				}
+			}
+			dragging_ = true;
+			dragStartY_ = my;
+			dragStartOffset_ = offset_;
+			changed = true;
+			return true;
+		case EventType::MouseMove:
+			if (!dragging_)
+				return false;
+			{
+				const float travel = viewport_.height - GetThumb().height;
+				if (travel > 0.0f)
+				{
+					changed = SetOffset(dragStartOffset_ + static_cast<double>(my - dragStartY_) * GetMaxOffset() / travel);
+				}
+			}
+			return true;
+		case EventType::MouseUp:
+			if (!dragging_)
+				return false;
+			dragging_ = false;
+			changed = true;
+			return true;
+		case EventType::MouseWheel:
+			if (!IsShown() || !inViewport)
+				return false;
+			changed = SetOffset(offset_ - event.wheelY * wheelStep);
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void ScrollBar::Paint(DrawList& drawList) const
+	{
+		if (!IsShown())
+			return;
+
+		Rect track(viewport_.x + viewport_.width - kWidth, viewport_.y, kWidth, viewport_.height);
+		drawList.AddRect(track, Color(0.2f, 0.2f, 0.2f, 1.0f));
+		drawList.AddRect(GetThumb(), dragging_ ? Color(0.7f, 0.7f, 0.7f, 1.0f) : Color(0.5f, 0.5f, 0.5f, 1.0f));
+	}
+
+} // namespace SnowUI
@@ -0,0 +1,380 @@
+#include "SnowUI/Widgets/TreeView.h"
+#include "SnowUI/Render/TextLayout.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SnowUI
+{
+
+	static constexpr float kCellPadding = 5.0f;
+	static constexpr float kExpanderSize = 9.0f;
+	static constexpr double kWheelRows = 3.0;
+	// Screens of rows the label cache holds, so short scrolls hit it
+	static constexpr size_t kCachedScreens = 3;
+
+	TreeView::TreeView() : provider_(nullptr), selectedNode_(kNoNode)
+	{
+		scroll_.SetViewport(bounds_);
+		ResizeLabelCache();
+	}
+
+	void TreeView::SetBounds(const Rect& bounds)
+	{
+		Widget::SetBounds(bounds);
+		scroll_.SetViewport(bounds_);
+		ResizeLabelCache();
+	}
+
+	void TreeView::SetProvider(ITreeProvider* provider)
+	{
+		provider_ = provider;
+		Refresh();
+	}
+
+	void TreeView::Refresh()
+	{
+		nodes_.clear();
+		rows_.clear();
+		selectedNode_ = kNoNode;
+		for (auto& label : labels_)
+		{
+			label.node = kNoNode;
+		}
+
+		if (provider_)
+		{
+			keyScratch_.clear();
+			provider_->GetRootItems(keyScratch_);
+			AppendNodes(keyScratch_, kNoNode, 0);
+			rows_.resize(nodes_.size());
+			for (uint32_t i = 0; i < rows_.size(); ++i)
+			{
+				rows_[i] = i;
+			}
+		}
+
+		scroll_.SetOffset(0.0);
+		UpdateScrollRange();
+		Invalidate();
+	}
+
+	void TreeView::AppendNodes(const std::vector<TreeItemKey>& keys, uint32_t parent, uint32_t depth)
+	{
+		for (TreeItemKey key : keys)
+		{
+			Node node;
+			node.key = key;
+			node.parent = parent;
+			node.firstChild = kNoNode;
+			node.childCount = 0;
+			node.depth = depth;
+			node.hasChildren = provider_->HasChildren(key);
+			node.childrenLoaded = false;
+			node.expanded = false;
+			nodes_.push_back(node);
+		}
+	}
+
+	void TreeView::LoadChildren(uint32_t node)
+	{
+		if (nodes_[node].childrenLoaded)
+			return;
+
+		keyScratch_.clear();
+		provider_->GetChildren(nodes_[node].key, keyScratch_);
+		const uint32_t first = static_cast<uint32_t>(nodes_.size());
+		AppendNodes(keyScratch_, node, nodes_[node].depth + 1);
+
+		Node& loaded = nodes_[node];
+		loaded.firstChild = first;
+		loaded.childCount = static_cast<uint32_t>(keyScratch_.size());
+		loaded.childrenLoaded = true;
+		loaded.hasChildren = loaded.childCount > 0;
+	}
+
+	void TreeView::CollectVisible(uint32_t node, std::vector<uint32_t>& out) const
+	{
+		// Depth-first with an explicit stack; children are pushed in reverse
+		// so they pop in order
+		std::vector<uint32_t> stack;
+		const Node& root = nodes_[node];
+		for (uint32_t i = root.childCount; i-- > 0;)
+		{
+			stack.push_back(root.firstChild + i);
+		}
+		while (!stack.empty())
+		{
+			const uint32_t current = stack.back();
+			stack.pop_back();
+			out.push_back(current);
+
+			const Node& child = nodes_[current];
+			if (child.expanded)
+			{
+				for (uint32_t i = child.childCount; i-- > 0;)
+				{
+					stack.push_back(child.firstChild + i);
+				}
+			}
+		}
+	}
+
+	void TreeView::ExpandRow(size_t row)
+	{
+		if (row >= rows_.size())
+			return;
+
+		const uint32_t node = rows_[row];
+		if (nodes_[node].expanded || !nodes_[node].hasChildren)
+			return;
+
+		LoadChildren(node);
+		nodes_[node].expanded = true;
+
+		// Descendants expanded before the last collapse come back with it
+		rowScratch_.clear();
+		CollectVisible(node, rowScratch_);
+		rows_.insert(rows_.begin() + static_cast<std::ptrdiff_t>(row + 1), rowScratch_.begin(), rowScratch_.end());
+
+		UpdateScrollRange();
+		Invalidate();
+	}
+
+	void TreeView::CollapseRow(size_t row)
+	{
+		if (row >= rows_.size())
+			return;
+
+		const uint32_t node = rows_[row];
+		if (!nodes_[node].expanded)
+			return;
+
+		nodes_[node].expanded = false;
+
+		// The visible descendants are exactly the deeper rows that follow
+		const uint32_t depth = nodes_[node].depth;
+		size_t end = row + 1;
+		while (end < rows_.size() && nodes_[rows_[end]].depth > depth)
+		{
+			++end;
+		}
+		rows_.erase(rows_.begin() + static_cast<std::ptrdiff_t>(row + 1),
+		            rows_.begin() + static_cast<std::ptrdiff_t>(end));
+
+		UpdateScrollRange();
+		Invalidate();
+	}
+
+	void TreeView::ToggleRow(size_t row)
+	{
+		if (row >= rows_.size())
+			return;
+
+		if (nodes_[rows_[row]].expanded)
+			CollapseRow(row);
+		else
+			ExpandRow(row);
+	}
+
+	bool TreeView::GetSelectedItem(TreeItemKey& item) const
+	{
+		if (selectedNode_ == kNoNode)
+			return false;
+
+		item = nodes_[selectedNode_].key;
+		return true;
+	}
+
+	void TreeView::SetSelectedRow(size_t row)
+	{
+		const uint32_t node = row < rows_.size() ? rows_[row] : kNoNode;
+		if (node == selectedNode_)
+			return;
+
+		selectedNode_ = node;
+		Invalidate();
+	}
+
+	void TreeView::ResizeLabelCache()
+	{
+		const size_t screenRows = static_cast<size_t>(std::ceil(std::max(bounds_.height, 0.0f) / kRowHeight)) + 1;
+		const size_t capacity = std::max<size_t>(screenRows * kCachedScreens, 16);
+		if (capacity == labels_.size())
+			return;
+
+		// Slots are keyed by node modulo the capacity, so they all move
+		labels_.resize(capacity);
+		for (auto& label : labels_)
+		{
+			label.node = kNoNode;
+		}
+	}
+
+	const std::string& TreeView::GetLabel(uint32_t node)
+	{
+		CachedLabel& slot = labels_[node % labels_.size()];
+		if (slot.node != node)
+		{
+			slot.node = node;
+			provider_->FormatLabel(nodes_[node].key, slot.text);
+		}
+		return slot.text;
+	}
+
+	void TreeView::UpdateScrollRange()
+	{
+		scroll_.SetContentHeight(static_cast<double>(rows_.size()) * kRowHeight);
+	}
+
+	void TreeView::SetScrollOffset(double offset)
+	{
+		if (scroll_.SetOffset(offset))
+		{
+			Invalidate();
+		}
+	}
+
+	void TreeView::EnsureVisible(size_t row)
+	{
+		if (row >= rows_.size())
+			return;
+
+		const double top = static_cast<double>(row) * kRowHeight;
+		if (scroll_.ScrollIntoView(top, top + kRowHeight))
+		{
+			Invalidate();
+		}
+	}
+
+	float TreeView::GetRowTop(size_t row) const
+	{
+		return bounds_.y + static_cast<float>(static_cast<double>(row) * kRowHeight - scroll_.GetOffset());
+	}
+
+	void TreeView::GetVisibleRange(size_t& first, size_t& last) const
+	{
+		const double offset = scroll_.GetOffset();
+		const double height = std::max(bounds_.height, 0.0f);
+		first = static_cast<size_t>(offset / kRowHeight);
+		last = std::min(static_cast<size_t>(std::ceil((offset + height) / kRowHeight)), rows_.size());
+		first = std::min(first, last);
+	}
+
+	float TreeView::GetExpanderX(size_t row) const
+	{
+		return bounds_.x + kCellPadding + static_cast<float>(nodes_[rows_[row]].depth) * kIndent;
+	}
+
+	size_t TreeView::GetRowAt(float x, float y) const
+	{
+		if (x < bounds_.x || x > bounds_.x + bounds_.width || y < bounds_.y || y >= bounds_.y + bounds_.height)
+			return kNoRow;
+
+		const size_t row = static_cast<size_t>((y - bounds_.y + scroll_.GetOffset()) / kRowHeight);
+		return row < rows_.size() ? row : kNoRow;
+	}
+
+	void TreeView::OnPaint(DrawList& drawList)
+	{
+		if (!visible_)
+			return;
+
+		drawList.AddRect(bounds_, Color(0.25f, 0.25f, 0.25f, 1.0f));
+		if (rows_.empty() || bounds_.height <= 0.0f)
+			return;
+
+		const float right = bounds_.x + (scroll_.IsShown() ? bounds_.width - ScrollBar::kWidth : bounds_.width);
+		const float bottom = bounds_.y + bounds_.height;
+		const float lineHeight = MeasureText("").height;
+		const Color expanderColor(0.7f, 0.7f, 0.7f, 1.0f);
+
+		size_t first, last;
+		GetVisibleRange(first, last);
+		for (size_t row = first; row < last; ++row)
+		{
+			const uint32_t node = rows_[row];
+			const float y = GetRowTop(row);
+			if (node == selectedNode_)
+			{
+				const float selTop = std::max(y, bounds_.y);
+				const float selBottom = std::min(y + kRowHeight, bottom);
+				drawList.AddRect(Rect(bounds_.x, selTop, right - bounds_.x, selBottom - selTop),
+				                 Color(0.4f, 0.4f, 0.6f, 1.0f));
+			}
+
+			// Text has no clipping, so rows cut by the edges show only their
+			// background
+			const float textY = y + std::round((kRowHeight - lineHeight) * 0.5f);
+			if (textY < bounds_.y || textY + lineHeight > bottom)
+				continue;
+
+			const float expanderX = GetExpanderX(row);
+			if (expanderX + kExpanderSize > right)
+				continue;
+
+			// A boxed minus, with a vertical bar added while collapsed
+			if (nodes_[node].hasChildren)
+			{
+				const float x0 = expanderX;
+				const float y0 = y + std::round((kRowHeight - kExpanderSize) * 0.5f);
+				const float x1 = x0 + kExpanderSize;
+				const float y1 = y0 + kExpanderSize;
+				const float midX = x0 + kExpanderSize * 0.5f;
+				const float midY = y0 + kExpanderSize * 0.5f;
+				drawList.AddLine(x0, y0, x1, y0, expanderColor);
+				drawList.AddLine(x1, y0, x1, y1, expanderColor);
+				drawList.AddLine(x1, y1, x0, y1, expanderColor);
+				drawList.AddLine(x0, y1, x0, y0, expanderColor);
+				drawList.AddLine(x0 + 2.0f, midY, x1 - 2.0f, midY, expanderColor);
+				if (!nodes_[node].expanded)
+				{
+					drawList.AddLine(midX, y0 + 2.0f, midX, y1 - 2.0f, expanderColor);
+				}
+			}
+
+			const std::string& label = GetLabel(node);
+			const float textX = expanderX + kIndent;
+			if (textX + MeasureText(label).width <= right)
+			{
+				drawList.AddText(label, textX, textY, Color(1.0f, 1.0f, 1.0f, 1.0f));
+			}
+		}
+
+		scroll_.Paint(drawList);
+	}
+
+	void TreeView::OnEvent(const Event& event)
+	{
+		if (!visible_)
+			return;
+
+		bool scrolled = false;
+		if (scroll_.HandleEvent(event, kWheelRows * kRowHeight, scrolled))
+		{
+			if (scrolled)
+				Invalidate();
+			event.handled = true;
+			return;
+		}
+
+		if (event.type == EventType::MouseDown)
+		{
+			const float mx = static_cast<float>(event.x);
+			const size_t row = GetRowAt(mx, static_cast<float>(event.y));
+			if (row == kNoRow)
+				return;
+
+			const float expanderX = GetExpanderX(row);
+			if (nodes_[rows_[row]].hasChildren && mx >= expanderX && mx < expanderX + kIndent)
+			{
+				ToggleRow(row);
+			}
+			else
+			{
+				SetSelectedRow(row);
+			}
+			event.handled = true;
+		}
+	}
+
+} // namespace SnowUI